@@ -0,0 +1,1264 @@
+#include <BudgetSearch.h>
+#include <CompressedGraph.h>
+#include <ConnectionScan.h>
+#include <CustomizableOverlay.h>
+#include <DeltaStepping.h>
+#include <Dijkstra.h>
+#include <GraphGenerator.h>
+#include <GraphLoader.h>
+#include <GraphReorder.h>
+#include <HubLabels.h>
+#include <Landmarks.h>
+#include <MemoryBoundedSearch.h>
+#include <MultiSourceBFS.h>
+#include <ParallelBFS.h>
+#include <PerfCounter.h>
+#include <Queue.h>
+#include <RouteCache.h>
+#include <SearchTreeCache.h>
+#include <ShardedRouting.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+//
+// ─────────────────────────────────────────────────────────────
+//  TIMING HELPERS
+// ─────────────────────────────────────────────────────────────
+//
+static void report(const string& label, double ms) {
+    cout << "  " << label;
+    for (int i = label.size(); i < 40; i++) cout << ' ';
+    cout << ms << " ms" << endl;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  STARTUP: loadEdgesCSV vs PARALLEL CHUNKED LOADER
+// ─────────────────────────────────────────────────────────────
+//
+// Writes a million random edges over the synthetic airports to a
+// temporary CSV and loads it line by line through addEdge, then in
+// chunks on one worker and on all of them. The loaded rows must match
+// the FlatGraph built from the sequential result.
+//
+static void addAirports(Graph& g, int n) {
+    for (int v = 0; v < n; v++)
+        g.addVertex(new Vertex("A" + to_string(v)));
+}
+
+static void benchLoader(int n, int threads) {
+    cout << "Startup (loading an edge CSV)" << endl;
+
+    const int LINES = 1000000;
+    const string file = "/tmp/flight_bench_edges.csv";
+    ofstream out(file);
+    Random rng(37);
+    for (int i = 0; i < LINES; i++)
+        out << rng.between(0, n - 1) << ',' << rng.between(0, n - 1) << ','
+            << rng.between(50, 900) << ',' << rng.between(40, 720) << '\n';
+    long size = (long)out.tellp();
+    out.close();
+    cout << "  " << LINES << " lines, " << size / (1024 * 1024) << " MB" << endl;
+
+    Graph sequential;
+    addAirports(sequential, n);
+    auto t0 = chrono::steady_clock::now();
+    loadEdgesCSV(sequential, file);
+    FlatGraph expected(sequential);
+    report("loadEdgesCSV + FlatGraph", millisSince(t0));
+
+    ThreadPool single(1);
+    ThreadPool pool(threads);
+    ThreadPool* pools[] = { &single, &pool };
+    for (ThreadPool* p : pools) {
+        Graph g;
+        addAirports(g, n);
+        EdgeLoadStats stats;
+        auto t1 = chrono::steady_clock::now();
+        FlatGraph* flat = loadEdgesCSVParallel(g, file, *p, &stats);
+        report("chunked loader, " + to_string(p->size()) + " threads", millisSince(t1));
+        cout << "    read " << stats.readMs << " ms, parse " << stats.parseMs
+             << " ms, build " << stats.buildMs << " ms (" << stats.chunks
+             << " chunks)" << endl;
+
+        int mismatches = flat == nullptr || flat->m != expected.m ? 1 : 0;
+        for (int e = 0; mismatches == 0 && e < expected.m; e++)
+            if (flat->targets[e] != expected.targets[e] || flat->price[e] != expected.price[e])
+                mismatches++;
+        for (int v = 0; mismatches == 0 && v < n; v++)
+            if (g.vertices[v]->edgeList.size() != expected.degree(v))
+                mismatches++;
+        cout << "  mismatches: " << mismatches << endl;
+        delete flat;
+    }
+
+    remove(file.c_str());
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  ONE-TO-ALL: Graph::ucs vs DELTA-STEPPING
+// ─────────────────────────────────────────────────────────────
+//
+// Graph::ucs keeps a sorted array frontier, so it is only timed while the
+// graph is small enough to finish. In that case a few of its point-to-point
+// answers are also checked against the parallel tree.
+//
+static void benchSSSP(Graph& g, const FlatGraph& flat, int threads) {
+    cout << "SSSP (one-to-all, price)" << endl;
+
+    const int UCS_LIMIT = 3000;
+    Vertex* source = g.vertices[0];
+
+    if (g.vertices.size() <= UCS_LIMIT) {
+        auto t0 = chrono::steady_clock::now();
+        g.ucs(source, nullptr, USE_PRICE);
+        report("Graph::ucs (sequential)", millisSince(t0));
+    } else {
+        cout << "  Graph::ucs skipped above " << UCS_LIMIT << " vertices"
+             << endl;
+    }
+
+    ThreadPool single(1);
+    auto t1 = chrono::steady_clock::now();
+    ShortestPathTree* seq = DeltaStepping(flat, single).run(source->id, USE_PRICE);
+    report("delta-stepping, 1 thread", millisSince(t1));
+
+    ThreadPool pool(threads);
+    auto t2 = chrono::steady_clock::now();
+    ShortestPathTree* par = DeltaStepping(flat, pool).run(source->id, USE_PRICE);
+    report("delta-stepping, " + to_string(pool.size()) + " threads",
+           millisSince(t2));
+
+    int mismatches = 0;
+    for (int v = 0; v < flat.n; v++)
+        if (seq->dist[v] != par->dist[v] || seq->pred[v] != par->pred[v])
+            mismatches++;
+
+    Random rng(7);
+    int checks = g.vertices.size() <= UCS_LIMIT ? 5 : 0;
+    for (int i = 0; i < checks; i++) {
+        Vertex* dest = g.vertices[rng.between(0, g.vertices.size() - 1)];
+        Route r = g.ucs(source, dest, USE_PRICE);
+        if (!r.found() || r.totalPrice != par->dist[dest->id])
+            mismatches++;
+    }
+
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete seq;
+    delete par;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  FEWEST STOPS: Graph::bfs vs DIRECTION-OPTIMIZING BFS
+// ─────────────────────────────────────────────────────────────
+//
+static void benchBFS(Graph& g, const FlatGraph& flat, int threads) {
+    cout << "BFS (fewest stops, 20 random pairs)" << endl;
+
+    const int BFS_LIMIT = 20000;
+    const int PAIRS = 20;
+
+    Random rng(11);
+    int* from = new int[PAIRS];
+    int* to = new int[PAIRS];
+    for (int i = 0; i < PAIRS; i++) {
+        from[i] = rng.between(0, flat.n - 1);
+        to[i] = rng.between(0, flat.n - 1);
+    }
+
+    ThreadPool pool(threads);
+    auto t0 = chrono::steady_clock::now();
+    DirectionOptimizingBFS engine(flat, pool);
+    report("transpose build", millisSince(t0));
+
+    auto t1 = chrono::steady_clock::now();
+    ArrayList<Route> routes;
+    for (int i = 0; i < PAIRS; i++)
+        routes.append(engine.route(from[i], to[i]));
+    report("direction-optimizing, " + to_string(pool.size()) + " threads",
+           millisSince(t1));
+
+    if (g.vertices.size() > BFS_LIMIT) {
+        cout << "  Graph::bfs skipped above " << BFS_LIMIT << " vertices"
+             << endl;
+    } else {
+        int mismatches = 0;
+        auto t2 = chrono::steady_clock::now();
+        for (int i = 0; i < PAIRS; i++) {
+            Route r = g.bfs(g.vertices[from[i]], g.vertices[to[i]]);
+
+            bool same = r.vertices.size() == routes[i].vertices.size();
+            for (int k = 0; same && k < r.vertices.size(); k++)
+                same = r.vertices[k] == routes[i].vertices[k] &&
+                       (k == r.legs.size() || r.legs[k] == routes[i].legs[k]);
+
+            if (!same) mismatches++;
+        }
+        report("Graph::bfs (sequential)", millisSince(t2));
+        cout << "  path mismatches: " << mismatches << endl;
+    }
+
+    delete[] from;
+    delete[] to;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  HOP MATRIX: ONE BFS PER SOURCE vs BIT-PARALLEL BATCHES
+// ─────────────────────────────────────────────────────────────
+//
+// Fewest stops from a block of sources to every airport. Graph::bfs
+// answers one pair at a time, so it is timed on a few pairs and scaled
+// up; the fair baseline is one queue-based BFS over the FlatGraph per
+// source. The batched sweep must give the same matrix.
+//
+static void singleSourceHops(const FlatGraph& flat, int source, int* hops, int* queue) {
+    for (int v = 0; v < flat.n; v++) hops[v] = INT_MAX;
+    int head = 0, tail = 0;
+    hops[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+        int u = queue[head++];
+        for (int e = flat.offsets[u]; e < flat.offsets[u + 1]; e++) {
+            int v = flat.targets[e];
+            if (hops[v] != INT_MAX) continue;
+            hops[v] = hops[u] + 1;
+            queue[tail++] = v;
+        }
+    }
+}
+
+static void benchHopMatrix(Graph& g, const FlatGraph& flat, int threads) {
+    const int PAIRS = 20;
+    int rows = flat.n < 1024 ? flat.n : 1024;
+    cout << "Hop matrix (" << rows << " sources x " << flat.n << " airports)" << endl;
+
+    Random rng(43);
+    int* sources = new int[rows];
+    int* all = new int[flat.n];
+    for (int i = 0; i < rows; i++) sources[i] = rng.between(0, flat.n - 1);
+    for (int v = 0; v < flat.n; v++) all[v] = v;
+
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < PAIRS; i++)
+        g.bfs(g.vertices[sources[i % rows]], g.vertices[rng.between(0, flat.n - 1)]);
+    double perPair = millisSince(t0) / PAIRS;
+    cout << "  Graph::bfs: " << perPair * 1000 << " us per pair, about "
+         << (long)(perPair * rows * flat.n / 1000) << " s for the matrix" << endl;
+
+    int* expected = new int[(long)rows * flat.n];
+    int* queue = new int[flat.n];
+    auto t1 = chrono::steady_clock::now();
+    for (int i = 0; i < rows; i++)
+        singleSourceHops(flat, sources[i], expected + (long)i * flat.n, queue);
+    report("one flat BFS per source", millisSince(t1));
+
+    ThreadPool single(1);
+    ThreadPool pool(threads);
+    ThreadPool* pools[] = { &single, &pool };
+    for (ThreadPool* p : pools) {
+        auto t2 = chrono::steady_clock::now();
+        HopMatrix* m = hopMatrix(flat, sources, rows, all, flat.n, *p);
+        report(to_string(MultiSourceBFS::LANES) + "-lane batches, " + to_string(p->size())
+               + " threads", millisSince(t2));
+
+        long mismatches = 0;
+        for (long k = 0; k < (long)rows * flat.n; k++)
+            if (m->hops[k] != expected[k]) mismatches++;
+        cout << "  mismatches: " << mismatches << endl;
+        delete m;
+    }
+
+    delete[] sources;
+    delete[] all;
+    delete[] expected;
+    delete[] queue;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  VERTEX LAYOUT: ORIGINAL vs RCM vs HUB CLUSTERING
+// ─────────────────────────────────────────────────────────────
+//
+// Runs the same single-threaded workload (a few one-to-all searches and
+// fewest-stops pairs, all picked by original id) on each layout and
+// reports time and last-level cache misses relative to the original.
+//
+struct LayoutCost {
+    double ms;
+    long long misses;
+};
+
+static LayoutCost runLayout(const FlatGraph& flat, const int* toLocal) {
+    const int SOURCES = 5;
+    const int PAIRS = 20;
+
+    ThreadPool single(1);
+    DeltaStepping sssp(flat, single);
+    DirectionOptimizingBFS bfs(flat, single);
+    PerfCounter counter;
+    Random rng(23);
+
+    auto t0 = chrono::steady_clock::now();
+    counter.start();
+
+    for (int i = 0; i < SOURCES; i++)
+        delete sssp.run(toLocal[rng.between(0, flat.n - 1)], USE_TIME);
+    for (int i = 0; i < PAIRS; i++) {
+        int a = toLocal[rng.between(0, flat.n - 1)];
+        int b = toLocal[rng.between(0, flat.n - 1)];
+        bfs.route(a, b);
+    }
+
+    long long misses = counter.stop();
+    return { millisSince(t0), misses };
+}
+
+static string change(double base, double now, const string& better,
+                     const string& worse) {
+    int pct = (int)(100 * (base - now) / base);
+    return pct >= 0 ? to_string(pct) + "% " + better
+                    : to_string(-pct) + "% " + worse;
+}
+
+// `base` is the layout to compare against, or nullptr for the baseline.
+static void reportLayout(const string& label, LayoutCost cost,
+                         const LayoutCost* base) {
+    string time = label + ": " + to_string((int)cost.ms) + " ms";
+    if (base)
+        time += " (" + change(base->ms, cost.ms, "faster", "slower") + ")";
+
+    string misses = "cache misses: n/a";
+    if (cost.misses >= 0) {
+        misses = "cache misses: " + to_string(cost.misses);
+        if (base && base->misses > 0)
+            misses += " (" + change(base->misses, cost.misses, "fewer", "more") + ")";
+    }
+
+    cout << "  " << time;
+    for (int i = time.size(); i < 40; i++) cout << ' ';
+    cout << misses << endl;
+}
+
+static void benchLayout(const FlatGraph& flat) {
+    cout << "Vertex layout (1 thread)" << endl;
+
+    int* identity = new int[flat.n];
+    for (int v = 0; v < flat.n; v++) identity[v] = v;
+    LayoutCost base = runLayout(flat, identity);
+    reportLayout("original", base, nullptr);
+    delete[] identity;
+
+    auto t0 = chrono::steady_clock::now();
+    int* rcm = reverseCuthillMcKee(flat);
+    ReorderedGraph byRcm(flat, rcm);
+    report("RCM reorder", millisSince(t0));
+    reportLayout("RCM", runLayout(*byRcm.graph, byRcm.toLocal), &base);
+    delete[] rcm;
+
+    auto t1 = chrono::steady_clock::now();
+    int* hubs = hubClustering(flat);
+    ReorderedGraph byHubs(flat, hubs);
+    report("hub clustering reorder", millisSince(t1));
+    reportLayout("hub clustering", runLayout(*byHubs.graph, byHubs.toLocal), &base);
+    delete[] hubs;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  COMPRESSED ADJACENCY
+// ─────────────────────────────────────────────────────────────
+//
+// Bytes per edge for the pointer-based Graph (an Edge allocation, its
+// malloc header and the edgeList slot), the FlatGraph and the varint
+// CompressedGraph, with and without RCM renumbering (which keeps
+// neighbour ids close, so gaps fit in one byte). Then the same Dijkstra
+// queries on the flat and compressed layouts.
+//
+static void reportBytes(const string& label, double bytes, int m) {
+    cout << "  " << label;
+    for (int i = label.size(); i < 40; i++) cout << ' ';
+    cout << (long)(bytes / 1024) << " KB, " << bytes / m << " bytes/edge" << endl;
+}
+
+static void benchCompressed(const FlatGraph& flat) {
+    cout << "Compressed adjacency (memory and point-to-point Dijkstra)" << endl;
+
+    const long MALLOC_HEADER = 16;
+    double pointerBytes = (double)flat.m * (sizeof(Edge) + MALLOC_HEADER + sizeof(Edge*));
+    double flatBytes = (double)(flat.n + 1) * sizeof(int) + (double)flat.m * 3 * sizeof(int);
+    reportBytes("Graph (Edge objects)", pointerBytes, flat.m);
+    reportBytes("FlatGraph", flatBytes, flat.m);
+
+    auto t0 = chrono::steady_clock::now();
+    CompressedGraph compressed(flat);
+    double buildMs = millisSince(t0);
+    reportBytes("CompressedGraph", compressed.bytesUsed(), flat.m);
+
+    int* rcm = reverseCuthillMcKee(flat);
+    ReorderedGraph renumbered(flat, rcm);
+    CompressedGraph compact(*renumbered.graph);
+    reportBytes("CompressedGraph after RCM", compact.bytesUsed(), flat.m);
+    delete[] rcm;
+
+    cout << "  widths: price " << compressed.price.width << ", time "
+         << compressed.time.width << ", edge slot " << compressed.slot.width
+         << " bytes; build " << buildMs << " ms" << endl;
+
+    const int QUERIES = 200;
+    Random rng(29);
+    int* sources = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    int* expected = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        dests[q] = rng.between(0, flat.n - 1);
+    }
+
+    Dijkstra dijkstra(flat);
+    auto t1 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++)
+        expected[q] = dijkstra.query(sources[q], dests[q], q % 2 ? USE_TIME : USE_PRICE);
+    report("Dijkstra on FlatGraph", millisSince(t1));
+
+    CompressedDijkstra packed(compressed);
+    int mismatches = 0;
+    auto t2 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++)
+        if (packed.query(sources[q], dests[q], q % 2 ? USE_TIME : USE_PRICE) != expected[q])
+            mismatches++;
+    report("Dijkstra on CompressedGraph", millisSince(t2));
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] dests;
+    delete[] expected;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  ROUTE CACHE
+// ─────────────────────────────────────────────────────────────
+//
+// Skewed workload: 90% of queries come from a small hot set of pairs,
+// asked in either direction. Every cached answer is checked against a
+// fresh search, and a re-priced edge must empty the cache.
+//
+static void benchCache(Graph& g, const FlatGraph& flat) {
+    cout << "Route cache (price, skewed queries)" << endl;
+
+    const int QUERIES = 20000;
+    const int HOT = 64;
+    int n = flat.n;
+
+    Random rng(11);
+    int* hotStart = new int[HOT];
+    int* hotDest = new int[HOT];
+    for (int i = 0; i < HOT; i++) {
+        hotStart[i] = rng.between(0, n - 1);
+        hotDest[i] = rng.between(0, n - 1);
+    }
+
+    int* starts = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        if (rng.between(0, 9) < 9) {
+            int i = rng.between(0, HOT - 1);
+            bool flip = rng.between(0, 1);
+            starts[q] = flip ? hotDest[i] : hotStart[i];
+            dests[q] = flip ? hotStart[i] : hotDest[i];
+        } else {
+            starts[q] = rng.between(0, n - 1);
+            dests[q] = rng.between(0, n - 1);
+        }
+    }
+
+    Dijkstra dijkstra(flat);
+    auto t0 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++)
+        dijkstra.route(starts[q], dests[q], USE_PRICE);
+    report("Dijkstra, no cache", millisSince(t0));
+
+    RouteCache cache(g, 256);
+    auto t1 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+        Route route;
+        if (!cache.lookup(starts[q], dests[q], 0, route))
+            cache.store(starts[q], dests[q], 0,
+                        dijkstra.route(starts[q], dests[q], USE_PRICE));
+    }
+    report("Dijkstra behind RouteCache", millisSince(t1));
+
+    cout << "  hit rate: " << (int)(cache.hitRate() * 100) << "% ("
+         << cache.reverseHitCount() << " reversed, "
+         << cache.evictionCount() << " evictions)" << endl;
+
+    int mismatches = 0;
+    for (int i = 0; i < HOT; i++) {
+        Route cached;
+        if (!cache.lookup(hotDest[i], hotStart[i], 0, cached)) continue;
+
+        Route fresh = dijkstra.route(hotDest[i], hotStart[i], USE_PRICE);
+        if (cached.totalPrice != fresh.totalPrice ||
+            cached.vertices.size() != fresh.vertices.size()) {
+            mismatches++;
+            continue;
+        }
+
+        int price = 0;
+        for (int k = 0; k < cached.legs.size(); k++) {
+            Edge* e = g.leg(cached, k);
+            if (e->to->id != cached.vertices[k + 1]) mismatches++;
+            price += e->price;
+        }
+        if (price != cached.totalPrice) mismatches++;
+    }
+
+    Vertex* a = g.vertices[0];
+    g.setEdgeWeights(a, a->edgeList[0]->to, a->edgeList[0]->price,
+                     a->edgeList[0]->time);
+    Route stale;
+    if (cache.lookup(hotStart[0], hotDest[0], 0, stale) || cache.size() != 0)
+        mismatches++;
+
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] hotStart;
+    delete[] hotDest;
+    delete[] starts;
+    delete[] dests;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SEARCH TREE CACHE
+// ─────────────────────────────────────────────────────────────
+//
+// Browsing workload: a handful of start airports, each followed by a run
+// of destinations, alternating price and time.
+//
+static void benchTrees(const FlatGraph& flat) {
+    cout << "Search tree cache (browsing from a few sources)" << endl;
+
+    const int SOURCES = 4;
+    const int CLICKS = 200;
+
+    Random rng(13);
+    int* sources = new int[SOURCES * CLICKS];
+    int* dests = new int[SOURCES * CLICKS];
+    for (int s = 0; s < SOURCES; s++) {
+        int source = rng.between(0, flat.n - 1);
+        for (int c = 0; c < CLICKS; c++) {
+            sources[s * CLICKS + c] = source;
+            dests[s * CLICKS + c] = rng.between(0, flat.n - 1);
+        }
+    }
+    int queries = SOURCES * CLICKS;
+
+    Dijkstra dijkstra(flat);
+    int* expected = new int[queries];
+    auto t0 = chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        WeightMode mode = q % 2 ? USE_TIME : USE_PRICE;
+        expected[q] = dijkstra.query(sources[q], dests[q], mode);
+    }
+    report("Dijkstra from scratch", millisSince(t0));
+
+    SearchTreeCache trees(flat, 8);
+    int mismatches = 0;
+    auto t1 = chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        WeightMode mode = q % 2 ? USE_TIME : USE_PRICE;
+        Route r = trees.route(sources[q], dests[q], mode);
+        int cost = !r.found() ? INT_MAX
+                 : mode == USE_PRICE ? r.totalPrice : r.totalTime;
+        if (cost != expected[q]) mismatches++;
+    }
+    report("SearchTreeCache", millisSince(t1));
+
+    cout << "  " << trees.hitCount() << " settled, " << trees.resumeCount()
+         << " resumed, " << trees.restartCount() << " started" << endl;
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] dests;
+    delete[] expected;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  ALT LANDMARKS
+// ─────────────────────────────────────────────────────────────
+//
+static void reportAlt(const string& label, const FlatGraph& flat,
+                      const Landmarks& landmarks, double buildMs,
+                      const int* sources, const int* dests,
+                      const int* expected, int queries) {
+    AltSearch alt(flat, landmarks);
+    long expanded = 0;
+    int mismatches = 0;
+
+    auto t0 = chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        WeightMode mode = q % 2 ? USE_TIME : USE_PRICE;
+        Route r = alt.route(sources[q], dests[q], mode);
+        int cost = !r.found() ? INT_MAX
+                 : mode == USE_PRICE ? r.totalPrice : r.totalTime;
+        if (cost != expected[q]) mismatches++;
+        expanded += r.stats.nodesExpanded;
+    }
+    double ms = millisSince(t0);
+
+    cout << "  " << label << ": build " << (int)buildMs << " ms, "
+         << landmarks.bytes() / 1024 << " KB, queries " << ms << " ms, "
+         << expanded / queries << " expanded/query, mismatches: "
+         << mismatches << endl;
+}
+
+static void benchAlt(const FlatGraph& flat, int threads) {
+    cout << "ALT landmarks (random pairs, price and time)" << endl;
+
+    const int QUERIES = 400;
+    Random rng(17);
+    int* sources = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    int* expected = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        dests[q] = rng.between(0, flat.n - 1);
+    }
+
+    Dijkstra dijkstra(flat);
+    auto t0 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++)
+        expected[q] = dijkstra.query(sources[q], dests[q],
+                                     q % 2 ? USE_TIME : USE_PRICE);
+    report("Dijkstra", millisSince(t0));
+
+    ThreadPool pool(threads);
+    int counts[] = { 4, 8, 16 };
+    for (int count : counts) {
+        auto t1 = chrono::steady_clock::now();
+        Landmarks avoid(flat, pool, count, LANDMARKS_AVOID);
+        reportAlt(to_string(count) + " avoid", flat, avoid, millisSince(t1),
+                  sources, dests, expected, QUERIES);
+    }
+
+    auto t2 = chrono::steady_clock::now();
+    Landmarks farthest(flat, pool, 8, LANDMARKS_FARTHEST);
+    reportAlt("8 farthest", flat, farthest, millisSince(t2),
+              sources, dests, expected, QUERIES);
+
+    delete[] sources;
+    delete[] dests;
+    delete[] expected;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  MEMORY-BOUNDED SEARCH: IDA* AND SMA*
+// ─────────────────────────────────────────────────────────────
+//
+// Per-query memory against time. "held" is the most search nodes alive
+// at once: every Waypoint for Graph::ucs (only timed on small graphs),
+// path frames for IDA*, node slots for SMA*. All answers are checked
+// against Dijkstra.
+//
+static void benchBounded(Graph& g, const FlatGraph& flat, int threads) {
+    cout << "Memory-bounded search (16 landmarks, random pairs)" << endl;
+
+    const int UCS_LIMIT = 3000;
+    const int QUERIES = 40;
+    Random rng(23);
+    int* sources = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    int* expected = new int[QUERIES];
+
+    Dijkstra dijkstra(flat);
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        dests[q] = rng.between(0, flat.n - 1);
+        expected[q] = dijkstra.query(sources[q], dests[q],
+                                     q % 2 ? USE_TIME : USE_PRICE);
+    }
+
+    auto line = [](const string& label, double ms, long held) {
+        report(label, ms);
+        cout << "    held at most " << held << " nodes" << endl;
+    };
+
+    if (g.vertices.size() <= UCS_LIMIT) {
+        const int UCS_QUERIES = 4;
+        long held = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (int q = 0; q < UCS_QUERIES; q++) {
+            Route r = g.ucs(g.vertices[sources[q]], g.vertices[dests[q]],
+                            q % 2 ? USE_TIME : USE_PRICE);
+            if (r.stats.waypointsAllocated > held) held = r.stats.waypointsAllocated;
+        }
+        line("Graph::ucs, first " + to_string(UCS_QUERIES) + " queries",
+             millisSince(t0), held);
+    } else {
+        cout << "  Graph::ucs skipped above " << UCS_LIMIT << " vertices"
+             << endl;
+    }
+
+    ThreadPool pool(threads);
+    Landmarks landmarks(flat, pool, 16);
+    int mismatches = 0;
+
+    auto run = [&](const string& label, auto& search) {
+        long held = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES; q++) {
+            WeightMode mode = q % 2 ? USE_TIME : USE_PRICE;
+            Route r = search.route(sources[q], dests[q], mode);
+            int cost = !r.found() ? INT_MAX
+                     : mode == USE_PRICE ? r.totalPrice : r.totalTime;
+            if (cost != expected[q]) mismatches++;
+            if (r.stats.peakFrontier > held) held = r.stats.peakFrontier;
+        }
+        line(label, millisSince(t0), held);
+    };
+
+    IDAStar ida(flat, &landmarks);
+    run("IDA*", ida);
+
+    int budgets[] = { 4096, 1024, 256 };
+    for (int budget : budgets) {
+        SMAStar sma(flat, budget, &landmarks);
+        run("SMA*, " + to_string(budget) + " nodes (" +
+            to_string(sma.bytes() / 1024) + " KB)", sma);
+    }
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] dests;
+    delete[] expected;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  HUB LABELS
+// ─────────────────────────────────────────────────────────────
+//
+static void benchHubLabels(const FlatGraph& flat) {
+    cout << "Hub labels (2-hop distance oracle)" << endl;
+
+    auto t0 = chrono::steady_clock::now();
+    HubLabels labels(flat);
+    report("build (price + time)", millisSince(t0));
+
+    cout << "  " << labels.entries() << " entries, "
+         << labels.bytes() / 1024 << " KB, average label "
+         << (int)labels.averageLabel(USE_PRICE) << " (price) / "
+         << (int)labels.averageLabel(USE_TIME) << " (time)" << endl;
+
+    const string file = "/tmp/flight-planner-bench.hlb";
+    HubLabels loaded;
+    auto t1 = chrono::steady_clock::now();
+    bool roundTrip = labels.save(file) && loaded.load(file);
+    report("save + load", millisSince(t1));
+    remove(file.c_str());
+
+    const int QUERIES = 100000;
+    const int CHECKS = 400;
+    Random rng(19);
+    int* sources = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        dests[q] = rng.between(0, flat.n - 1);
+    }
+
+    int reachable = 0;
+    auto t2 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++)
+        if (loaded.distance(sources[q], dests[q],
+                            q % 2 ? USE_TIME : USE_PRICE) != INT_MAX)
+            reachable++;
+    double ms = millisSince(t2);
+    cout << "  " << QUERIES << " distance queries: " << ms << " ms ("
+         << ms * 1000 / QUERIES << " us each, " << reachable
+         << " reachable)" << endl;
+
+    Dijkstra dijkstra(flat);
+    int mismatches = roundTrip ? 0 : 1;
+    for (int q = 0; q < CHECKS; q++) {
+        WeightMode mode = q % 2 ? USE_TIME : USE_PRICE;
+        int expected = dijkstra.query(sources[q], dests[q], mode);
+        Route r = loaded.route(flat, sources[q], dests[q], mode);
+
+        int cost = !r.found() ? INT_MAX
+                 : mode == USE_PRICE ? r.totalPrice : r.totalTime;
+        if (cost != expected ||
+            labels.distance(sources[q], dests[q], mode) != expected)
+            mismatches++;
+    }
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] dests;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  BUDGET SEARCH
+// ─────────────────────────────────────────────────────────────
+//
+// Work should grow with the number of airports inside the budget, not
+// with the graph. Answers are checked against a full one-to-all tree.
+//
+static void benchBudget(const FlatGraph& flat) {
+    cout << "Budget search (price, from vertex 0)" << endl;
+
+    ThreadPool single(1);
+    ShortestPathTree* all = DeltaStepping(flat, single).run(0, USE_PRICE);
+
+    int farthest = 0;
+    for (int v = 0; v < flat.n; v++)
+        if (all->reached(v) && all->dist[v] > farthest) farthest = all->dist[v];
+
+    BudgetSearch search(flat);
+    ArrayList<Reachable> found;
+    int mismatches = 0;
+
+    int fractions[] = { 5, 10, 25, 50, 100 };
+    for (int percent : fractions) {
+        int budget = (int)((long)farthest * percent / 100);
+        SearchStats stats = search.run(0, BUDGET_PRICE, budget, found);
+
+        int expected = 0;
+        for (int v = 0; v < flat.n; v++)
+            if (all->reached(v) && all->dist[v] <= budget) expected++;
+        if (found.size() != expected) mismatches++;
+        for (int i = 0; i < found.size(); i++)
+            if (found[i].cost != all->dist[found[i].vertex]) mismatches++;
+
+        cout << "  $" << budget << ": " << found.size() << " reachable, "
+             << stats.edgesRelaxed << " edges relaxed, " << stats.searchMs
+             << " ms" << endl;
+    }
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete all;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SET-TO-SET QUERIES
+// ─────────────────────────────────────────────────────────────
+//
+// "Any of these 4 airports to any of those 4": one seeded search against
+// the best of the 16 point-to-point answers.
+//
+static void benchMulti(const FlatGraph& flat) {
+    cout << "Set-to-set queries (4 starts x 4 destinations, 50 rounds)" << endl;
+
+    const int ROUNDS = 50;
+    const int SIDE = 4;
+    Random rng(23);
+    Dijkstra dijkstra(flat);
+
+    ArrayList<int>* sources = new ArrayList<int>[ROUNDS];
+    ArrayList<int>* targets = new ArrayList<int>[ROUNDS];
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < SIDE; i++) {
+            sources[r].append(rng.between(0, flat.n - 1));
+            targets[r].append(rng.between(0, flat.n - 1));
+        }
+    }
+
+    int* best = new int[ROUNDS];
+    auto t0 = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        best[r] = INT_MAX;
+        for (int i = 0; i < SIDE; i++) {
+            for (int j = 0; j < SIDE; j++) {
+                int cost = dijkstra.query(sources[r][i], targets[r][j], USE_PRICE);
+                if (cost < best[r]) best[r] = cost;
+            }
+        }
+    }
+    report("cross product of Dijkstra", millisSince(t0));
+
+    int mismatches = 0;
+    auto t1 = chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        Route route = dijkstra.route(sources[r], targets[r], USE_PRICE);
+        int cost = route.found() ? route.totalPrice : INT_MAX;
+        if (cost != best[r]) mismatches++;
+        if (route.found() &&
+            (!sources[r].search(route.vertices[0]) ||
+             !targets[r].search(route.vertices[route.vertices.size() - 1])))
+            mismatches++;
+    }
+    report("one seeded search", millisSince(t1));
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] targets;
+    delete[] best;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  CONNECTION SCAN
+// ─────────────────────────────────────────────────────────────
+//
+// Synthetic timetable: 8 departures a day on every route for two days.
+// Journeys are checked leg by leg, and every profile option must match
+// an earliest-arrival query at its departure time.
+//
+static int checkJourney(const Timetable& table, const Journey& journey,
+                        int source, int target, int departure) {
+    const Connection* c = table.connections;
+    int errors = 0;
+    int at = source, ready = departure;
+
+    for (int i = 0; i < journey.legs.size(); i++) {
+        const Connection& board = c[journey.legs[i].board];
+        const Connection& alight = c[journey.legs[i].alight];
+        if (board.from != at || board.departure < ready ||
+            board.trip != alight.trip)
+            errors++;
+
+        at = alight.to;
+        ready = alight.arrival + table.transferTime;
+    }
+
+    if (at != target) errors++;
+    return errors;
+}
+
+static void benchTimetable(const FlatGraph& flat) {
+    cout << "Connection scan (timetable, 8 flights/day/route, 2 days)" << endl;
+
+    ArrayList<Connection> list;
+    generateTimetable(list, flat, 8, 2);
+
+    auto t0 = chrono::steady_clock::now();
+    Timetable table(flat.n, list);
+    report("sort " + to_string(table.count) + " connections", millisSince(t0));
+
+    const int QUERIES = 200;
+    Random rng(29);
+    ConnectionScan csa(table);
+    int errors = 0, reached = 0;
+    long scanned = 0;
+
+    int* sources = new int[QUERIES];
+    int* targets = new int[QUERIES];
+    int* departures = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        targets[q] = rng.between(0, flat.n - 1);
+        departures[q] = rng.between(0, 24 * 60 - 1);
+    }
+
+    auto t1 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+        long looked;
+        Journey j = csa.earliestArrival(sources[q], targets[q], departures[q],
+                                        &looked);
+        scanned += looked;
+        if (j.found()) reached++;
+    }
+    double ms = millisSince(t1);
+    cout << "  " << QUERIES << " earliest-arrival queries: " << ms << " ms, "
+         << scanned / QUERIES << " connections scanned/query, " << reached
+         << " reached" << endl;
+
+    for (int q = 0; q < QUERIES; q++) {
+        Journey j = csa.earliestArrival(sources[q], targets[q], departures[q]);
+        if (j.found())
+            errors += checkJourney(table, j, sources[q], targets[q], departures[q]);
+    }
+
+    const int PROFILES = 10;
+    long options = 0;
+    auto t2 = chrono::steady_clock::now();
+    ArrayList<ProfileEntry>* profiles = new ArrayList<ProfileEntry>[PROFILES];
+    for (int q = 0; q < PROFILES; q++)
+        profiles[q] = csa.profile(sources[q], targets[q], 0, 24 * 60 - 1);
+    ms = millisSince(t2);
+
+    for (int q = 0; q < PROFILES; q++) {
+        options += profiles[q].size();
+        for (int k = 0; k < profiles[q].size(); k++) {
+            const ProfileEntry& option = profiles[q][k];
+            Journey j = csa.earliestArrival(sources[q], targets[q], option.departure);
+            if (j.arrival != option.arrival) errors++;
+        }
+    }
+    cout << "  " << PROFILES << " one-day profile queries: " << ms << " ms, "
+         << options / PROFILES << " options/query" << endl;
+    cout << "  mismatches: " << errors << endl;
+
+    delete[] profiles;
+    delete[] sources;
+    delete[] targets;
+    delete[] departures;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  CUSTOMIZABLE OVERLAY: RE-PRICING WITHOUT A REBUILD
+// ─────────────────────────────────────────────────────────────
+//
+// A regional network, partitioned once. Every fare is then replaced and
+// only the price cliques are recomputed; hub labels, the other exact
+// index here, would have to be built again from scratch. Overlay
+// answers after the re-price are checked against Dijkstra.
+//
+static void benchOverlay(int n, int threads) {
+    const int QUERIES = 1000;
+    cout << "Customizable overlay (re-pricing every route)" << endl;
+
+    Graph g;
+    generateRegionalGraph(g, n, 8, 16, 31);
+    FlatGraph flat(g);
+
+    auto t0 = chrono::steady_clock::now();
+    CustomizableOverlay overlay(flat);
+    report("partition (once per topology)", millisSince(t0));
+    cout << "  " << overlay.levelsUsed() << " levels, " << overlay.boundaryVertices()
+         << " boundary entries, " << overlay.cliqueEntries() << " clique entries per mode"
+         << endl;
+
+    ThreadPool single(1);
+    ThreadPool pool(threads);
+    auto t1 = chrono::steady_clock::now();
+    overlay.customize(single);
+    report("customize price + time, 1 thread", millisSince(t1));
+
+    Random rng(47);
+    for (int e = 0; e < flat.m; e++)
+        flat.price[e] = rng.between(50, 900);
+
+    ThreadPool* pools[] = { &single, &pool };
+    for (ThreadPool* p : pools) {
+        auto t2 = chrono::steady_clock::now();
+        overlay.customize(USE_PRICE, *p);
+        report("re-price, " + to_string(p->size()) + " threads", millisSince(t2));
+    }
+
+    auto t3 = chrono::steady_clock::now();
+    HubLabels labels(flat);
+    report("hub labels rebuild (for scale)", millisSince(t3));
+
+    int* sources = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        dests[q] = rng.between(0, flat.n - 1);
+    }
+
+    OverlayQuery query(overlay);
+    Dijkstra dijkstra(flat);
+    int* costs = new int[QUERIES];
+    long overlayExpanded = 0, dijkstraExpanded = 0;
+
+    auto t4 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+        SearchStats stats;
+        costs[q] = query.query(sources[q], dests[q], USE_PRICE, &stats);
+        overlayExpanded += stats.nodesExpanded;
+    }
+    report(to_string(QUERIES) + " overlay queries", millisSince(t4));
+
+    int mismatches = 0;
+    auto t5 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+        ArrayList<int> from, to;
+        from.append(sources[q]);
+        to.append(dests[q]);
+        Route r = dijkstra.route(from, to, USE_PRICE);
+        dijkstraExpanded += r.stats.nodesExpanded;
+        if ((r.found() ? r.totalPrice : INT_MAX) != costs[q]) mismatches++;
+    }
+    report(to_string(QUERIES) + " Dijkstra queries", millisSince(t5));
+    cout << "  expanded per query: " << overlayExpanded / QUERIES << " overlay, "
+         << dijkstraExpanded / QUERIES << " Dijkstra" << endl;
+    cout << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] dests;
+    delete[] costs;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SHARDED ROUTING (worker process per partition)
+// ─────────────────────────────────────────────────────────────
+//
+// A regional network (the random one has no small cuts to find) split
+// by recursive bisection. Each shard is served by its own process; the
+// coordinator only holds the overlay. Costs are checked against
+// Dijkstra over the whole network.
+//
+static void benchSharded(int n) {
+    const int PARTS = 4;
+    const int QUERIES = 1000;
+    cout << "Sharded routing (" << PARTS << " worker processes)" << endl;
+
+    Graph g;
+    generateRegionalGraph(g, n, 8, 8, 29);
+    FlatGraph flat(g);
+
+    auto t0 = chrono::steady_clock::now();
+    RecursiveBisection bisection(flat);
+    Partition* partition = bisection.run(PARTS);
+    report("recursive bisection", millisSince(t0));
+    cout << "  " << partition->cutEdges << " of " << flat.m / 2
+         << " routes cut" << endl;
+
+    const string prefix = "/tmp/flight-bench-shards";
+    bool written = writeShards(flat, *partition, prefix);
+    delete partition;
+
+    ShardCoordinator coordinator;
+    auto t1 = chrono::steady_clock::now();
+    if (!written || !coordinator.launch(prefix)) {
+        cout << "  cannot start shard workers" << endl;
+        return;
+    }
+    report("start workers + build overlay", millisSince(t1));
+    cout << "  overlay " << coordinator.overlayVertices() << " vertices, "
+         << coordinator.overlayArcs() << " arcs" << endl;
+
+    Random rng(41);
+    int* sources = new int[QUERIES];
+    int* dests = new int[QUERIES];
+    for (int q = 0; q < QUERIES; q++) {
+        sources[q] = rng.between(0, flat.n - 1);
+        dests[q] = rng.between(0, flat.n - 1);
+    }
+
+    int* sharded = new int[QUERIES];
+    auto t2 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+        RouteReply r = coordinator.route(sources[q], dests[q], q % 2 ? MODE_TIME : MODE_PRICE);
+        sharded[q] = r.header.status != ROUTE_OK ? INT_MAX
+                   : q % 2 ? r.header.totalTime : r.header.totalPrice;
+    }
+    report(to_string(QUERIES) + " sharded routes", millisSince(t2));
+
+    Dijkstra dijkstra(flat);
+    int mismatches = 0;
+    auto t3 = chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++)
+        if (dijkstra.query(sources[q], dests[q], q % 2 ? USE_TIME : USE_PRICE) != sharded[q])
+            mismatches++;
+    report(to_string(QUERIES) + " whole-graph Dijkstra", millisSince(t3));
+    cout << "  mismatches: " << mismatches << endl;
+
+    for (int p = 0; p < coordinator.partCount(); p++)
+        remove(shardFile(prefix, p).c_str());
+    remove(overlayFile(prefix).c_str());
+    delete[] sources;
+    delete[] dests;
+    delete[] sharded;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  LIST NODES: new/delete vs NODE POOL
+// ─────────────────────────────────────────────────────────────
+//
+// The BFS frontier pattern: a queue that fills and drains over and over.
+// Heap allocations are counted after the first round, when the pool has
+// reached the peak length and should be recycling everything.
+//
+template <class Alloc>
+static void runQueue(const string& label, int rounds, int length) {
+    Queue<int, Alloc> queue;
+    long sum = 0;
+
+    for (int i = 0; i < length; i++) queue.enqueue(i);
+    while (!queue.isEmpty()) sum += queue.dequeue();
+    long warm = queue.allocationStats().heapAllocations;
+
+    auto t0 = chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < length; i++) queue.enqueue(i);
+        while (!queue.isEmpty()) sum += queue.dequeue();
+    }
+    double ms = millisSince(t0);
+
+    report(label, ms);
+    cout << "    heap allocations after warm-up: "
+         << queue.allocationStats().heapAllocations - warm
+         << " (checksum " << sum << ")" << endl;
+}
+
+static void benchNodePool() {
+    const int ROUNDS = 200;
+    const int LENGTH = 5000;
+    cout << "Queue nodes (" << ROUNDS << " rounds of " << LENGTH
+         << " enqueues and dequeues)" << endl;
+
+    runQueue<HeapNodes<Link<int>>>("new/delete per link", ROUNDS, LENGTH);
+    runQueue<NodePool<Link<int>>>("node pool", ROUNDS, LENGTH);
+}
+
+int main(int argc, char* argv[]) {
+    int vertices = argc > 1 ? atoi(argv[1]) : 2000;
+    int degree   = argc > 2 ? atoi(argv[2]) : 8;
+    int threads  = argc > 3 ? atoi(argv[3]) : 0;
+
+    cout << "Synthetic graph: " << vertices << " vertices, average degree "
+         << degree << endl;
+
+    Graph g;
+    generateGraph(g, vertices, degree);
+    FlatGraph flat(g);
+
+    cout << "  " << flat.m << " directed edges" << endl << endl;
+
+    benchLoader(vertices, threads);
+    cout << endl;
+    benchSSSP(g, flat, threads);
+    cout << endl;
+    benchBFS(g, flat, threads);
+    cout << endl;
+    benchHopMatrix(g, flat, threads);
+    cout << endl;
+    benchLayout(flat);
+    cout << endl;
+    benchCompressed(flat);
+    cout << endl;
+    benchCache(g, flat);
+    cout << endl;
+    benchTrees(flat);
+    cout << endl;
+    benchAlt(flat, threads);
+    cout << endl;
+    benchBounded(g, flat, threads);
+    cout << endl;
+    benchHubLabels(flat);
+    cout << endl;
+    benchBudget(flat);
+    cout << endl;
+    benchMulti(flat);
+    cout << endl;
+    benchTimetable(flat);
+    cout << endl;
+    benchOverlay(vertices, threads);
+    cout << endl;
+    benchSharded(vertices);
+    cout << endl;
+    benchNodePool();
+
+    return 0;
+}
@@ -11,9 +11,15 @@
 
 #include <FL/Fl_Scroll.H>
 #include <FL/Fl_Box.H>
+#include <FL/Fl_Int_Input.H>
 #include <FL/fl_draw.H>
 
+#include <FlightData.h>
 #include <Graph.h>
+#include <QueryLog.h>
+#include <RouteCache.h>
+#include <SearchWorker.h>
+#include <TraceProfiler.h>
 #include <string>
 
 // ------------------------------------------------------------
@@ -27,6 +33,7 @@ struct Point { int x, y; };
 class GraphDisplay : public Fl_Box {
     Graph* graphRef;
     std::vector<std::string> path;
+    std::vector<bool> reachable;   // by vertex index, see setReachable
 
 public:
     GraphDisplay(int X, int Y, int W, int H, Graph* g)
@@ -36,9 +43,25 @@ public:
         color(FL_WHITE);
     }
 
+    // Draw another graph (after a reload); clears any highlight
+    void setGraph(Graph* g) {
+        graphRef = g;
+        path.clear();
+        reachable.clear();
+        redraw();
+    }
+
     // Set a new path to highlight
     void setPath(const std::vector<std::string>& p) {
         path = p;
+        reachable.clear();
+        redraw();
+    }
+
+    // Highlight a set of airports (by vertex index) instead of a path
+    void setReachable(const std::vector<bool>& r) {
+        reachable = r;
+        path.clear();
         redraw();
     }
 
@@ -69,6 +92,7 @@ public:
     // DRAWING ROUTINE — called automatically
     // ------------------------------------------------------------
     void draw() override {
+        TRACE_SCOPE("GraphDisplay::draw");
         fl_color(FL_WHITE);
         fl_rectf(x(), y(), w(), h());
 
@@ -125,7 +149,9 @@ public:
             for (auto& s : path)
                 if (s == v->data) highlight = true;
 
-            fl_color(highlight ? FL_RED : FL_BLUE);
+            bool inReach = i < (int)reachable.size() && reachable[i];
+
+            fl_color(highlight ? FL_RED : inReach ? FL_DARK_GREEN : FL_BLUE);
             fl_pie(p.x - 5, p.y - 5, 10, 10, 0, 360);
 
             fl_color(FL_BLACK);
@@ -145,23 +171,64 @@ class Application : public bobcat::Application_ {
     bobcat::Window*   window;
     bobcat::Dropdown* start;
     bobcat::Dropdown* dest;
+    bobcat::Button*   addStart;
+    bobcat::Button*   addDest;
     bobcat::Dropdown* mode;
     bobcat::Button*   search;
+    Fl_Int_Input*     budget;
+    bobcat::Button*   reach;
     Fl_Scroll*        results;
 
     GraphDisplay*     map;   // Visualization
 
-    // Data
+    // Extra acceptable airports picked with the "+" buttons (vertex ids)
+    ArrayList<int> alsoStart;
+    ArrayList<int> alsoDest;
+
+    // Data: the network and its search engines, reloaded in the
+    // background when the CSVs change (see initData). `shown` is the
+    // version the window lists; cities are its vertices.
+    ThreadPool pool;
+    SnapshotStore<FlightData> data;
+    SnapshotRef<FlightData> shown;
     ArrayList<Vertex*> cities;
-    Graph g;
+    DataWatcher* watcher;
+
+    // Background searches (see handleClick)
+    SearchWorker* searcher;
+    long lastJob;
+
+    // Finished routes, keyed by the dropdown triple
+    RouteCache* cache;
+
+    // Search instrumentation (see Application())
+    bool showStats;
+    std::string statsLog;
+    QueryRecorder* recorder;    // null unless FLIGHT_QUERY_LOG is set
 
     // Helpers
     void initData();
     void initInterface();
-    void loadAirports(const std::string& file);
-    void loadEdges(const std::string& file);
+    void showData();
 
     void handleClick(bobcat::Widget* sender);
+    void handleReach(bobcat::Widget* sender);
+    void handleAdd(bobcat::Widget* sender);
+    void updateChoiceLabels();
+    void handleChange(bobcat::Widget* sender);
+
+    static void dataReloaded(void* data);
+    static void onDataReloaded(void* data);
+    static void searchFinished(SearchJob* job);
+    static void onSearchDone(void* data);
+    static void onProgress(void* data);
+    void showProgress();
+    void showResult(SearchJob* job);
+    void showReachable(SearchJob* job);
+    void addStats(int& ry, const SearchStats& stats);
+    void logStats(Vertex* S, Vertex* D, int modeIndex, bool found,
+                  const SearchStats& stats);
+    void recordQuery(SearchJob* job, bool found);
 
 public:
     Application();
@@ -90,6 +90,22 @@ public:
         }
     }
 
+    // Makes room for `size` elements so appending up to that many does
+    // not reallocate.
+    void reserve(int size) {
+        if (size < capacity) return;
+
+        T *old = data;
+        capacity = size + 1;
+        data = new T[capacity];
+
+        for (int i = 0; i < count; i++) {
+            data[i] = old[i];
+        }
+
+        delete[] old;
+    }
+
     void prepend(T value) {
         for (int i = count; i > 0; i--) {
             data[i] = data[i - 1];
@@ -0,0 +1,99 @@
+#ifndef BUDGET_SEARCH_H
+#define BUDGET_SEARCH_H
+
+#include <FlatGraph.h>
+#include <MinHeap.h>
+#include <climits>
+
+//
+// ─── BUDGET SEARCH (ISOCHRONES) ────────────────────────────────────────
+//
+// "Where can I get for under $500 / within 6 hours / in two stops?"
+// A Dijkstra from one source that never queues a vertex costing more
+// than the budget, so it ends as soon as everything inside the bound is
+// settled. Scratch arrays are reset lazily with a query stamp: the work
+// is proportional to the vertices inside the bound and their edges, not
+// to the size of the graph. One object per thread.
+//
+struct Reachable {
+    int vertex;
+    int cost;
+};
+
+enum BudgetUnit { BUDGET_PRICE, BUDGET_TIME, BUDGET_STOPS };
+
+class BudgetSearch {
+    const FlatGraph& graph;
+    MinHeap heap;
+    int* dist;
+    int* stamp;
+    int current;
+
+    int distance(int v) const { return stamp[v] == current ? dist[v] : INT_MAX; }
+
+public:
+    explicit BudgetSearch(const FlatGraph& g)
+        : graph(g), heap(g.n), dist(new int[g.n]), stamp(new int[g.n]),
+          current(0)
+    {
+        for (int v = 0; v < g.n; v++)
+            stamp[v] = 0;
+    }
+
+    BudgetSearch(const BudgetSearch&) = delete;
+    BudgetSearch& operator=(const BudgetSearch&) = delete;
+
+    ~BudgetSearch() {
+        delete[] dist;
+        delete[] stamp;
+    }
+
+    // Every vertex reachable from source for at most `budget`, cheapest
+    // first, starting with the source itself at cost 0. Stops are counted
+    // as flights taken. Returns the stats of the search; `out` is left
+    // partial if it was cancelled through `control`.
+    SearchStats run(int source, BudgetUnit unit, int budget,
+                    ArrayList<Reachable>& out, SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
+        const int* w = unit == BUDGET_PRICE ? graph.price
+                     : unit == BUDGET_TIME ? graph.time : nullptr;
+        SearchStats stats;
+
+        out = ArrayList<Reachable>();
+        current++;
+        heap.clear();
+        if (budget < 0) return stats;
+
+        dist[source] = 0;
+        stamp[source] = current;
+        heap.push(source, 0);
+
+        while (!heap.isEmpty()) {
+            if (control && control->check(stats.nodesExpanded))
+                break;
+            if (heap.size() > stats.peakFrontier)
+                stats.peakFrontier = heap.size();
+
+            int u = heap.pop();
+            int du = dist[u];
+            out.append({ u, du });
+            stats.nodesExpanded++;
+
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                int dv = du + (w ? w[e] : 1);
+                stats.edgesRelaxed++;
+                if (dv <= budget && dv < distance(v)) {
+                    dist[v] = dv;
+                    stamp[v] = current;
+                    heap.push(v, dv);
+                }
+            }
+        }
+
+        stats.searchMs = millisSince(started);
+        return stats;
+    }
+};
+
+#endif
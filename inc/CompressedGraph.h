@@ -0,0 +1,325 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <FlatGraph.h>
+#include <MinHeap.h>
+#include <Sort.h>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+//
+// ─── NARROW COLUMN ─────────────────────────────────────────────────────
+//
+// One int per edge stored as an offset from the smallest value, in 1, 2
+// or 4 bytes depending on the range. Lossless: route costs come out
+// exactly as in the FlatGraph.
+//
+struct NarrowColumn {
+    int base;
+    int width;
+    unsigned char* data;
+
+    NarrowColumn() : base(0), width(1), data(nullptr) {}
+
+    NarrowColumn(const NarrowColumn&) = delete;
+    NarrowColumn& operator=(const NarrowColumn&) = delete;
+
+    ~NarrowColumn() {
+        delete[] data;
+    }
+
+    // values[order[i]] goes to slot i.
+    void fill(const int* values, const int* order, int count) {
+        int lo = 0, hi = 0;
+        for (int i = 0; i < count; i++) {
+            int x = values[order[i]];
+            if (i == 0 || x < lo) lo = x;
+            if (i == 0 || x > hi) hi = x;
+        }
+
+        unsigned range = (unsigned)hi - (unsigned)lo;
+        base = lo;
+        width = range < 0x100 ? 1 : range < 0x10000 ? 2 : 4;
+
+        delete[] data;
+        data = new unsigned char[count > 0 ? (long)count * width : 1];
+        for (int i = 0; i < count; i++) {
+            uint32_t x = (unsigned)values[order[i]] - (unsigned)lo;
+            if (width == 1) {
+                data[i] = (unsigned char)x;
+            } else if (width == 2) {
+                uint16_t y = (uint16_t)x;
+                memcpy(data + 2L * i, &y, 2);
+            } else {
+                memcpy(data + 4L * i, &x, 4);
+            }
+        }
+    }
+
+    int get(long i) const {
+        if (width == 1) return base + data[i];
+        if (width == 2) {
+            uint16_t y;
+            memcpy(&y, data + 2 * i, 2);
+            return base + y;
+        }
+        uint32_t x;
+        memcpy(&x, data + 4 * i, 4);
+        return (int)((unsigned)base + x);
+    }
+
+    long bytes(int count) const { return (long)count * width; }
+};
+
+//
+// ─── COMPRESSED GRAPH ──────────────────────────────────────────────────
+//
+// Read-only, compact copy of a FlatGraph for very large networks. Each
+// vertex's neighbours are sorted by id and stored as LEB128 varints: the
+// first as a zigzag offset from the vertex itself, the rest as gaps from
+// the one before. Ids that are close together (after GraphReorder, most
+// of them) take one byte. Price, time and the edge's position in the
+// original edgeList (Route::legs) are NarrowColumns indexed by compressed
+// edge id; edges of u are edgeStart[u] .. edgeStart[u + 1] - 1, in the
+// order they are decoded.
+//
+// Searches decode on the fly through forEachEdge; nothing is expanded
+// back into full arrays.
+//
+struct CompressedGraph {
+    int n;
+    int m;
+    long* byteStart;        // u's neighbours start at bytes + byteStart[u]
+    int* edgeStart;
+    unsigned char* bytes;
+    NarrowColumn price;
+    NarrowColumn time;
+    NarrowColumn slot;      // index in the original edgeList
+
+    static int varintSize(uint32_t x) {
+        int size = 1;
+        while (x >= 0x80) {
+            x >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    static unsigned char* writeVarint(unsigned char* p, uint32_t x) {
+        while (x >= 0x80) {
+            *p++ = (unsigned char)(x | 0x80);
+            x >>= 7;
+        }
+        *p++ = (unsigned char)x;
+        return p;
+    }
+
+    static uint32_t readVarint(const unsigned char*& p) {
+        uint32_t x = *p++;
+        if (x < 0x80) return x;
+        x &= 0x7f;
+        for (int shift = 7; ; shift += 7) {
+            uint32_t b = *p++;
+            x |= (b & 0x7f) << shift;
+            if (b < 0x80) return x;
+        }
+    }
+
+    static uint32_t zigzag(int x) { return ((uint32_t)x << 1) ^ (uint32_t)(x >> 31); }
+
+    static int unzigzag(uint32_t x) { return (int)(x >> 1) ^ -(int)(x & 1); }
+
+    explicit CompressedGraph(const FlatGraph& g)
+        : n(g.n), m(g.m), byteStart(new long[g.n + 1]), edgeStart(new int[g.n + 1])
+    {
+        // Flat edge ids, each vertex's run sorted by target.
+        int* order = new int[m];
+        for (int e = 0; e < m; e++) order[e] = e;
+        for (int u = 0; u < n; u++) {
+            mergeSort(order + g.offsets[u], g.degree(u), [&](int a, int b) {
+                return g.targets[a] < g.targets[b];
+            });
+        }
+
+        byteStart[0] = 0;
+        for (int u = 0; u < n; u++) {
+            long size = 0;
+            int previous = u;
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[order[e]];
+                size += e == g.offsets[u] ? varintSize(zigzag(v - u))
+                                          : varintSize(v - previous);
+                previous = v;
+            }
+            byteStart[u + 1] = byteStart[u] + size;
+            edgeStart[u] = g.offsets[u];
+        }
+        edgeStart[n] = m;
+
+        bytes = new unsigned char[byteStart[n] > 0 ? byteStart[n] : 1];
+        for (int u = 0; u < n; u++) {
+            unsigned char* p = bytes + byteStart[u];
+            int previous = u;
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[order[e]];
+                p = writeVarint(p, e == g.offsets[u] ? zigzag(v - u) : v - previous);
+                previous = v;
+            }
+        }
+
+        int* position = new int[m];
+        for (int u = 0; u < n; u++)
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++)
+                position[order[e]] = order[e] - g.offsets[u];
+
+        price.fill(g.price, order, m);
+        time.fill(g.time, order, m);
+        slot.fill(position, order, m);
+
+        delete[] order;
+        delete[] position;
+    }
+
+    CompressedGraph(const CompressedGraph&) = delete;
+    CompressedGraph& operator=(const CompressedGraph&) = delete;
+
+    ~CompressedGraph() {
+        delete[] byteStart;
+        delete[] edgeStart;
+        delete[] bytes;
+    }
+
+    int degree(int u) const { return edgeStart[u + 1] - edgeStart[u]; }
+
+    int weight(int e, WeightMode mode) const {
+        return mode == USE_PRICE ? price.get(e) : time.get(e);
+    }
+
+    // visit(e, v) for every edge e = u -> v, targets in increasing order.
+    template <typename Visit>
+    void forEachEdge(int u, Visit visit) const {
+        const unsigned char* p = bytes + byteStart[u];
+        int e = edgeStart[u], end = edgeStart[u + 1];
+        if (e == end) return;
+
+        int v = u + unzigzag(readVarint(p));
+        visit(e, v);
+        for (e++; e < end; e++) {
+            v += readVarint(p);
+            visit(e, v);
+        }
+    }
+
+    long bytesUsed() const {
+        return (long)(n + 1) * (sizeof(long) + sizeof(int)) + byteStart[n]
+             + price.bytes(m) + time.bytes(m) + slot.bytes(m);
+    }
+};
+
+//
+// ─── DIJKSTRA ON A COMPRESSED GRAPH ────────────────────────────────────
+//
+// Same search as Dijkstra, reading edges straight out of the varint
+// stream. Scratch arrays are reset lazily with a query stamp. One object
+// per thread.
+//
+class CompressedDijkstra {
+    const CompressedGraph& graph;
+    MinHeap heap;
+    int* dist;
+    int* predEdge;
+    int* predVertex;
+    int* stamp;
+    int current;
+
+    int distance(int v) const { return stamp[v] == current ? dist[v] : INT_MAX; }
+
+public:
+    explicit CompressedDijkstra(const CompressedGraph& g)
+        : graph(g), heap(g.n), dist(new int[g.n]), predEdge(new int[g.n]),
+          predVertex(new int[g.n]), stamp(new int[g.n]), current(0)
+    {
+        for (int v = 0; v < g.n; v++)
+            stamp[v] = 0;
+    }
+
+    CompressedDijkstra(const CompressedDijkstra&) = delete;
+    CompressedDijkstra& operator=(const CompressedDijkstra&) = delete;
+
+    ~CompressedDijkstra() {
+        delete[] dist;
+        delete[] predEdge;
+        delete[] predVertex;
+        delete[] stamp;
+    }
+
+    // Cheapest cost from source to dest (INT_MAX if unreachable).
+    int query(int source, int dest, WeightMode mode, SearchStats* stats = nullptr) {
+        const NarrowColumn& w = mode == USE_PRICE ? graph.price : graph.time;
+        current++;
+        heap.clear();
+
+        dist[source] = 0;
+        predEdge[source] = -1;
+        stamp[source] = current;
+        heap.push(source, 0);
+
+        long expanded = 0, relaxed = 0;
+        while (!heap.isEmpty()) {
+            int u = heap.pop();
+            if (u == dest) break;
+            expanded++;
+
+            int du = dist[u];
+            graph.forEachEdge(u, [&](int e, int v) {
+                int dv = du + w.get(e);
+                relaxed++;
+                if (dv < distance(v)) {
+                    dist[v] = dv;
+                    predEdge[v] = e;
+                    predVertex[v] = u;
+                    stamp[v] = current;
+                    heap.push(v, dv);
+                }
+            });
+        }
+
+        if (stats) {
+            stats->nodesExpanded = expanded;
+            stats->edgesRelaxed = relaxed;
+        }
+        return distance(dest);
+    }
+
+    // Legs are positions in the original edgeList, as for every Route.
+    Route route(int source, int dest, WeightMode mode) {
+        auto started = std::chrono::steady_clock::now();
+        Route result;
+        int cost = query(source, dest, mode, &result.stats);
+        result.stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (cost != INT_MAX) {
+            ArrayList<int> reversed;
+            for (int v = dest; predEdge[v] >= 0; v = predVertex[v])
+                reversed.append(v);
+
+            result.vertices.append(source);
+            for (int i = reversed.size() - 1; i >= 0; i--) {
+                int v = reversed[i];
+                int e = predEdge[v];
+                result.vertices.append(v);
+                result.legs.append(graph.slot.get(e));
+                result.totalPrice += graph.price.get(e);
+                result.totalTime += graph.time.get(e);
+            }
+            int count = result.vertices.size();
+            result.stops = count > 1 ? count - 2 : 0;
+        }
+        result.stats.extractMs = millisSince(extracting);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef CONNECTION_SCAN_H
+#define CONNECTION_SCAN_H
+
+#include <Timetable.h>
+#include <climits>
+
+//
+// ─── JOURNEY ───────────────────────────────────────────────────────────
+//
+// Answer to a timetable query: one leg per trip ridden, each from the
+// connection where it was boarded to the one where it was left (indices
+// into Timetable::connections). Empty if the target cannot be reached.
+//
+struct JourneyLeg {
+    int board;
+    int alight;
+};
+
+struct Journey {
+    ArrayList<JourneyLeg> legs;
+    int departure;
+    int arrival;        // INT_MAX if unreachable
+
+    Journey() : departure(0), arrival(INT_MAX) {}
+
+    bool found() const { return arrival != INT_MAX; }
+};
+
+//
+// One Pareto-optimal option of a profile query: leave at `departure`,
+// arrive at `arrival`. No option leaves later and arrives earlier.
+//
+struct ProfileEntry {
+    int departure;
+    int arrival;
+};
+
+//
+// ─── CONNECTION SCAN ───────────────────────────────────────────────────
+//
+// Dibbelt, Pajor, Strasser & Wagner's Connection Scan Algorithm. An
+// earliest-arrival query is one forward pass over the departure-sorted
+// connection array, starting at the requested time and stopping once
+// departures pass the best arrival at the target; each connection is a
+// couple of array reads, with no heap and no pointer chasing.
+//
+// A connection can be used if its trip was already boarded, or if the
+// earliest arrival at its departure station leaves at least the transfer
+// time (none at the origin). Profile queries run the same array
+// backwards and keep, per station, the Pareto set of (departure,
+// arrival at target) pairs.
+//
+// Scratch arrays are sized once and reset lazily with a stamp, so a
+// query costs only the connections it scans; one object per thread.
+//
+class ConnectionScan {
+    const Timetable& table;
+    int* arrival;       // earliest arrival per station
+    int* reachedBy;     // connection that gave it
+    int* stationStamp;
+    int* boarded;       // per trip: first connection taken
+    int* tripArrival;   // per trip, for profiles: earliest arrival at target
+    int* tripStamp;
+    int current;
+
+    int arrivalAt(int station) const {
+        return stationStamp[station] == current ? arrival[station] : INT_MAX;
+    }
+
+    int boardedAt(int trip) const {
+        return tripStamp[trip] == current ? boarded[trip] : -1;
+    }
+
+    int earliestTransfer(int station, int source) const {
+        int at = arrivalAt(station);
+        if (at == INT_MAX) return INT_MAX;
+        return station == source ? at : at + table.transferTime;
+    }
+
+public:
+    explicit ConnectionScan(const Timetable& t)
+        : table(t), arrival(new int[t.stations]), reachedBy(new int[t.stations]),
+          stationStamp(new int[t.stations]), boarded(new int[t.trips]),
+          tripArrival(new int[t.trips]), tripStamp(new int[t.trips]), current(0)
+    {
+        for (int s = 0; s < t.stations; s++)
+            stationStamp[s] = 0;
+        for (int k = 0; k < t.trips; k++)
+            tripStamp[k] = 0;
+    }
+
+    ConnectionScan(const ConnectionScan&) = delete;
+    ConnectionScan& operator=(const ConnectionScan&) = delete;
+
+    ~ConnectionScan() {
+        delete[] arrival;
+        delete[] reachedBy;
+        delete[] stationStamp;
+        delete[] boarded;
+        delete[] tripArrival;
+        delete[] tripStamp;
+    }
+
+    // Earliest arrival at target for someone at source from `departure`
+    // on. `scanned` receives the number of connections looked at.
+    Journey earliestArrival(int source, int target, int departure,
+                            long* scanned = nullptr) {
+        Journey journey;
+        if (scanned) *scanned = 0;
+        if (source == target) {
+            journey.departure = journey.arrival = departure;
+            return journey;
+        }
+
+        current++;
+        stationStamp[source] = current;
+        arrival[source] = departure;
+        reachedBy[source] = -1;
+
+        const Connection* c = table.connections;
+        int first = table.firstDeparting(departure);
+        int i = first;
+        for (; i < table.count; i++) {
+            if (c[i].departure >= arrivalAt(target)) break;
+
+            if (boardedAt(c[i].trip) < 0) {
+                if (earliestTransfer(c[i].from, source) > c[i].departure) continue;
+                tripStamp[c[i].trip] = current;
+                boarded[c[i].trip] = i;
+            }
+
+            if (c[i].arrival < arrivalAt(c[i].to)) {
+                stationStamp[c[i].to] = current;
+                arrival[c[i].to] = c[i].arrival;
+                reachedBy[c[i].to] = i;
+            }
+        }
+        if (scanned) *scanned = i - first;
+
+        if (arrivalAt(target) == INT_MAX) return journey;
+
+        // Walk back trip by trip: the connection that reached a station,
+        // the one where its trip was boarded, and on from there.
+        ArrayList<JourneyLeg> reversed;
+        for (int s = target; s != source; ) {
+            int alight = reachedBy[s];
+            int board = boarded[c[alight].trip];
+            reversed.append({ board, alight });
+            s = c[board].from;
+        }
+        for (int k = reversed.size() - 1; k >= 0; k--)
+            journey.legs.append(reversed[k]);
+
+        journey.departure = c[journey.legs[0].board].departure;
+        journey.arrival = arrival[target];
+        return journey;
+    }
+
+    // Every Pareto-optimal (departure, arrival) option from source to
+    // target leaving in [from, to], earliest departure first. An option is
+    // left out if any later flight, in range or not, arrives no later.
+    ArrayList<ProfileEntry> profile(int source, int target, int from, int to,
+                                    long* scanned = nullptr) {
+        // profiles[s]: options from station s, departures decreasing
+        // (the scan runs backwards), so the back is the earliest one.
+        ArrayList<ProfileEntry>* profiles = new ArrayList<ProfileEntry>[table.stations];
+        current++;
+
+        const Connection* c = table.connections;
+        int first = table.firstDeparting(from);
+        long looked = 0;
+
+        for (int i = table.count - 1; i >= first; i--) {
+            looked++;
+            int trip = c[i].trip;
+            int best = c[i].to == target ? c[i].arrival : INT_MAX;
+            if (tripStamp[trip] == current && tripArrival[trip] < best) best = tripArrival[trip];
+
+            // Transfer at c.to: the earliest-leaving option that still
+            // makes the connection is the one that arrives earliest.
+            if (c[i].to != target) {
+                int ready = c[i].arrival + table.transferTime;
+                const ArrayList<ProfileEntry>& next = profiles[c[i].to];
+                for (int k = next.size() - 1; k >= 0; k--) {
+                    if (next[k].departure >= ready) {
+                        if (next[k].arrival < best) best = next[k].arrival;
+                        break;
+                    }
+                }
+            }
+
+            if (best == INT_MAX) continue;
+            if (tripStamp[trip] != current || best < tripArrival[trip]) {
+                tripStamp[trip] = current;
+                tripArrival[trip] = best;
+            }
+
+            ArrayList<ProfileEntry>& here = profiles[c[i].from];
+            int n = here.size();
+            if (n == 0 || best < here[n - 1].arrival) {
+                if (n > 0 && here[n - 1].departure == c[i].departure)
+                    here[n - 1].arrival = best;
+                else
+                    here.append({ c[i].departure, best });
+            }
+        }
+        if (scanned) *scanned = looked;
+
+        ArrayList<ProfileEntry> result;
+        const ArrayList<ProfileEntry>& options = profiles[source];
+        for (int k = options.size() - 1; k >= 0; k--)
+            if (options[k].departure <= to) result.append(options[k]);
+
+        delete[] profiles;
+        return result;
+    }
+};
+
+#endif
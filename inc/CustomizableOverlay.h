@@ -0,0 +1,422 @@
+#ifndef CUSTOMIZABLE_OVERLAY_H
+#define CUSTOMIZABLE_OVERLAY_H
+
+#include <FlatGraph.h>
+#include <GraphPartition.h>
+#include <MinHeap.h>
+#include <ThreadPool.h>
+#include <climits>
+
+//
+// ─── OVERLAY LEVEL ─────────────────────────────────────────────────────
+//
+// One level of the multilevel partition. A boundary vertex has a route
+// leaving its cell at this level; cell c's boundary vertices are
+// boundary[cellStart[c] .. cellStart[c + 1] - 1], and slot[v] is v's
+// index in that list (-1 for interior vertices). The clique of cell c is
+// a b x b matrix of in-cell distances between its boundary vertices,
+// row-major from cliqueStart[c], one matrix per weight mode.
+//
+struct OverlayLevel {
+    int cells;
+    int* cellStart;
+    int* boundary;
+    int* slot;
+    long* cliqueStart;
+    int* price;
+    int* time;
+
+    OverlayLevel()
+        : cells(0), cellStart(nullptr), boundary(nullptr), slot(nullptr),
+          cliqueStart(nullptr), price(nullptr), time(nullptr) {}
+
+    OverlayLevel(const OverlayLevel&) = delete;
+    OverlayLevel& operator=(const OverlayLevel&) = delete;
+
+    ~OverlayLevel() {
+        delete[] cellStart;
+        delete[] boundary;
+        delete[] slot;
+        delete[] cliqueStart;
+        delete[] price;
+        delete[] time;
+    }
+
+    int size(int c) const { return cellStart[c + 1] - cellStart[c]; }
+
+    int* weights(WeightMode mode) { return mode == USE_PRICE ? price : time; }
+
+    const int* weights(WeightMode mode) const { return mode == USE_PRICE ? price : time; }
+};
+
+//
+// ─── CELL SEARCH ───────────────────────────────────────────────────────
+//
+// Dijkstra scratch for one thread, reset lazily with a stamp. The
+// searches that use it supply their own edges.
+//
+struct CellSearch {
+    MinHeap heap;
+    int* dist;
+    int* predEdge;
+    int* stamp;
+    int current;
+
+    explicit CellSearch(int n)
+        : heap(n), dist(new int[n]), predEdge(new int[n]), stamp(new int[n]), current(0)
+    {
+        for (int v = 0; v < n; v++)
+            stamp[v] = 0;
+    }
+
+    CellSearch(const CellSearch&) = delete;
+    CellSearch& operator=(const CellSearch&) = delete;
+
+    ~CellSearch() {
+        delete[] dist;
+        delete[] predEdge;
+        delete[] stamp;
+    }
+
+    int distance(int v) const { return stamp[v] == current ? dist[v] : INT_MAX; }
+
+    void begin(int source) {
+        current++;
+        heap.clear();
+        dist[source] = 0;
+        predEdge[source] = -1;
+        stamp[source] = current;
+        heap.push(source, 0);
+    }
+
+    bool improve(int v, int d, int edge) {
+        if (d >= distance(v)) return false;
+        dist[v] = d;
+        predEdge[v] = edge;
+        stamp[v] = current;
+        heap.push(v, d);
+        return true;
+    }
+};
+
+//
+// ─── CUSTOMIZABLE OVERLAY ──────────────────────────────────────────────
+//
+// Customizable Route Planning (Delling, Goldberg, Pajor & Werneck). The
+// airports are split once by recursive bisection into nested cells:
+// every level-l cell is FANOUT level-(l-1) cells, level 0 being the
+// finest. That part depends only on which routes exist.
+//
+// Customization fills each cell's clique from the current fares and
+// times: at level 0 by Dijkstra inside the cell over real routes, above
+// that over the level below's cliques plus the routes between its
+// subcells. Cells of one level are independent and run across the pool,
+// so re-pricing the whole network costs a few small searches per cell
+// and none of the partitioning. Call customize(mode) again whenever that
+// mode's weights in the FlatGraph change.
+//
+class CustomizableOverlay {
+public:
+    static const int FANOUT_BITS = 2;
+    static const int FANOUT = 1 << FANOUT_BITS;
+
+private:
+    const FlatGraph& graph;
+    int levelCount;
+    int* part;              // finest cell of every vertex
+    OverlayLevel* levels;
+
+    void buildLevel(int l) {
+        OverlayLevel& L = levels[l];
+        int n = graph.n;
+        L.cells = 1 << (FANOUT_BITS * (levelCount - l));
+        L.cellStart = new int[L.cells + 1];
+        L.slot = new int[n];
+
+        for (int c = 0; c <= L.cells; c++)
+            L.cellStart[c] = 0;
+        for (int v = 0; v < n; v++) {
+            L.slot[v] = -1;
+            for (int e = graph.offsets[v]; e < graph.offsets[v + 1]; e++) {
+                if (cell(l, graph.targets[e]) != cell(l, v)) {
+                    L.slot[v] = L.cellStart[cell(l, v) + 1]++;
+                    break;
+                }
+            }
+        }
+        for (int c = 0; c < L.cells; c++)
+            L.cellStart[c + 1] += L.cellStart[c];
+
+        L.boundary = new int[L.cellStart[L.cells] > 0 ? L.cellStart[L.cells] : 1];
+        for (int v = 0; v < n; v++)
+            if (L.slot[v] >= 0)
+                L.boundary[L.cellStart[cell(l, v)] + L.slot[v]] = v;
+
+        L.cliqueStart = new long[L.cells + 1];
+        L.cliqueStart[0] = 0;
+        for (int c = 0; c < L.cells; c++)
+            L.cliqueStart[c + 1] = L.cliqueStart[c] + (long)L.size(c) * L.size(c);
+
+        long entries = L.cliqueStart[L.cells] > 0 ? L.cliqueStart[L.cells] : 1;
+        L.price = new int[entries];
+        L.time = new int[entries];
+    }
+
+    // Clique arcs out of boundary vertex u of cell c at this level.
+    void relaxClique(const OverlayLevel& L, int c, int u, int du, WeightMode mode,
+                     CellSearch& s) const {
+        int b = L.size(c);
+        const int* row = L.weights(mode) + L.cliqueStart[c] + (long)L.slot[u] * b;
+        const int* entries = L.boundary + L.cellStart[c];
+        for (int j = 0; j < b; j++)
+            if (row[j] != INT_MAX && entries[j] != u)
+                s.improve(entries[j], du + row[j], -1);
+    }
+
+    // Distances between cell c's boundary vertices, staying in the cell.
+    void customizeCell(int l, int c, WeightMode mode, CellSearch& s) {
+        OverlayLevel& L = levels[l];
+        int b = L.size(c);
+        const int* entries = L.boundary + L.cellStart[c];
+        int* clique = L.weights(mode) + L.cliqueStart[c];
+        const int* w = graph.weights(mode);
+
+        for (int i = 0; i < b; i++) {
+            s.begin(entries[i]);
+            int settled = 0;
+            while (!s.heap.isEmpty() && settled < b) {
+                int u = s.heap.pop();
+                if (L.slot[u] >= 0) settled++;
+                int du = s.dist[u];
+
+                if (l == 0) {
+                    for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+                        if (cell(0, graph.targets[e]) == c)
+                            s.improve(graph.targets[e], du + w[e], e);
+                    continue;
+                }
+
+                // u is a boundary vertex of its subcell one level down.
+                const OverlayLevel& below = levels[l - 1];
+                int sc = cell(l - 1, u);
+                relaxClique(below, sc, u, du, mode, s);
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                    int v = graph.targets[e];
+                    if (cell(l - 1, v) != sc && cell(l, v) == c)
+                        s.improve(v, du + w[e], e);
+                }
+            }
+
+            for (int j = 0; j < b; j++)
+                clique[(long)i * b + j] = s.distance(entries[j]);
+        }
+    }
+
+public:
+    // `levels` nested levels of FANOUT-way splits (fewer on tiny graphs).
+    explicit CustomizableOverlay(const FlatGraph& g, int levels = 3)
+        : graph(g), levelCount(levels < 1 ? 1 : levels)
+    {
+        while (levelCount > 1 && (1L << (FANOUT_BITS * levelCount)) > g.n)
+            levelCount--;
+
+        RecursiveBisection bisection(g);
+        Partition* partition = bisection.run(1 << (FANOUT_BITS * levelCount));
+        part = new int[g.n > 0 ? g.n : 1];
+        for (int v = 0; v < g.n; v++)
+            part[v] = partition->part[v];
+        delete partition;
+
+        this->levels = new OverlayLevel[levelCount];
+        for (int l = 0; l < levelCount; l++)
+            buildLevel(l);
+    }
+
+    CustomizableOverlay(const CustomizableOverlay&) = delete;
+    CustomizableOverlay& operator=(const CustomizableOverlay&) = delete;
+
+    ~CustomizableOverlay() {
+        delete[] part;
+        delete[] levels;
+    }
+
+    // Recomputes every clique for `mode` from the graph's current weights.
+    void customize(WeightMode mode, ThreadPool& pool) {
+        int workers = pool.size();
+        CellSearch** scratch = new CellSearch*[workers];
+        for (int t = 0; t < workers; t++)
+            scratch[t] = nullptr;
+
+        for (int l = 0; l < levelCount; l++) {
+            pool.parallelFor(0, levels[l].cells, [&](int c, int worker) {
+                if (scratch[worker] == nullptr)
+                    scratch[worker] = new CellSearch(graph.n);
+                customizeCell(l, c, mode, *scratch[worker]);
+            }, 1);
+        }
+
+        for (int t = 0; t < workers; t++)
+            delete scratch[t];
+        delete[] scratch;
+    }
+
+    void customize(ThreadPool& pool) {
+        customize(USE_PRICE, pool);
+        customize(USE_TIME, pool);
+    }
+
+    const FlatGraph& flat() const { return graph; }
+
+    int levelsUsed() const { return levelCount; }
+
+    const OverlayLevel& level(int l) const { return levels[l]; }
+
+    int cell(int l, int v) const { return part[v] >> (FANOUT_BITS * l); }
+
+    long boundaryVertices() const {
+        long total = 0;
+        for (int l = 0; l < levelCount; l++)
+            total += levels[l].cellStart[levels[l].cells];
+        return total;
+    }
+
+    long cliqueEntries() const {
+        long total = 0;
+        for (int l = 0; l < levelCount; l++)
+            total += levels[l].cliqueStart[levels[l].cells];
+        return total;
+    }
+};
+
+//
+// ─── OVERLAY QUERY ─────────────────────────────────────────────────────
+//
+// Multilevel Dijkstra over a customized overlay. A vertex sharing its
+// finest cell with the source or the destination relaxes its real
+// routes. Any other vertex is on the boundary of the highest-level cell
+// that holds neither end; it relaxes that cell's clique, skipping the
+// inside, plus its routes out of the cell. Shortcuts are unpacked by a
+// Dijkstra restricted to their cell. One object per thread.
+//
+class OverlayQuery {
+    const CustomizableOverlay& overlay;
+    const FlatGraph& graph;
+    CellSearch search;
+    CellSearch unpack;
+    int* predVertex;
+
+    // Highest level whose cell around v holds neither s nor t, or -1.
+    int levelFor(int v, int s, int t) const {
+        for (int l = overlay.levelsUsed() - 1; l >= 0; l--)
+            if (overlay.cell(l, v) != overlay.cell(l, s) && overlay.cell(l, v) != overlay.cell(l, t))
+                return l;
+        return -1;
+    }
+
+    // Flat edges of the cheapest route from u to v inside u's level-l cell.
+    void cellPath(int u, int v, int l, WeightMode mode, ArrayList<int>& edges) {
+        const int* w = graph.weights(mode);
+        int c = overlay.cell(l, u);
+        unpack.begin(u);
+        while (!unpack.heap.isEmpty()) {
+            int x = unpack.heap.pop();
+            if (x == v) break;
+            for (int e = graph.offsets[x]; e < graph.offsets[x + 1]; e++)
+                if (overlay.cell(l, graph.targets[e]) == c)
+                    unpack.improve(graph.targets[e], unpack.dist[x] + w[e], e);
+        }
+
+        ArrayList<int> reversed;
+        for (int x = v; unpack.predEdge[x] >= 0; x = graph.edgeSource(unpack.predEdge[x]))
+            reversed.append(unpack.predEdge[x]);
+        for (int i = reversed.size() - 1; i >= 0; i--)
+            edges.append(reversed[i]);
+    }
+
+public:
+    explicit OverlayQuery(const CustomizableOverlay& o)
+        : overlay(o), graph(o.flat()), search(o.flat().n), unpack(o.flat().n),
+          predVertex(new int[o.flat().n]) {}
+
+    OverlayQuery(const OverlayQuery&) = delete;
+    OverlayQuery& operator=(const OverlayQuery&) = delete;
+
+    ~OverlayQuery() {
+        delete[] predVertex;
+    }
+
+    // Cheapest cost from s to t (INT_MAX if unreachable).
+    int query(int s, int t, WeightMode mode, SearchStats* stats = nullptr) {
+        const int* w = graph.weights(mode);
+        search.begin(s);
+        predVertex[s] = -1;
+
+        long expanded = 0, relaxed = 0;
+        while (!search.heap.isEmpty()) {
+            int u = search.heap.pop();
+            if (u == t) break;
+            expanded++;
+
+            int du = search.dist[u];
+            int l = levelFor(u, s, t);
+            int c = l >= 0 ? overlay.cell(l, u) : -1;
+            if (l >= 0) {
+                const OverlayLevel& L = overlay.level(l);
+                int b = L.size(c);
+                const int* row = L.weights(mode) + L.cliqueStart[c] + (long)L.slot[u] * b;
+                const int* entries = L.boundary + L.cellStart[c];
+                for (int j = 0; j < b; j++) {
+                    relaxed++;
+                    if (row[j] != INT_MAX && entries[j] != u &&
+                        search.improve(entries[j], du + row[j], -2 - l))
+                        predVertex[entries[j]] = u;
+                }
+            }
+
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                if (l >= 0 && overlay.cell(l, v) == c) continue;
+                relaxed++;
+                if (search.improve(v, du + w[e], e))
+                    predVertex[v] = u;
+            }
+        }
+
+        if (stats) {
+            stats->nodesExpanded = expanded;
+            stats->edgesRelaxed = relaxed;
+        }
+        return search.distance(t);
+    }
+
+    Route route(int s, int t, WeightMode mode) {
+        auto started = std::chrono::steady_clock::now();
+        Route result;
+        int cost = query(s, t, mode, &result.stats);
+        result.stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (cost != INT_MAX) {
+            ArrayList<int> hops;    // vertices from t back to s
+            for (int v = t; v != -1; v = predVertex[v])
+                hops.append(v);
+
+            ArrayList<int> edges;
+            for (int i = hops.size() - 1; i > 0; i--) {
+                int u = hops[i], v = hops[i - 1];
+                int pred = search.predEdge[v];
+                if (pred >= 0) edges.append(pred);
+                else cellPath(u, v, -2 - pred, mode, edges);
+            }
+
+            result.vertices.append(s);
+            for (int i = 0; i < edges.size(); i++)
+                result.vertices.append(graph.targets[edges[i]]);
+            graph.setLegs(result, edges);
+        }
+        result.stats.extractMs = millisSince(extracting);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include <FlatGraph.h>
+#include <ThreadPool.h>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+//
+// ─── SHORTEST PATH TREE ────────────────────────────────────────────────
+//
+// One-to-all answer: dist[v] is the cheapest cost from source to v
+// (INT_MAX if unreachable), pred[v] the previous vertex on that route and
+// predEdge[v] the flat edge id used to reach v (-1 for the source).
+//
+struct ShortestPathTree {
+    int n;
+    int source;
+    WeightMode mode;
+    int* dist;
+    int* pred;
+    int* predEdge;
+
+    ShortestPathTree(int count, int src, WeightMode m)
+        : n(count), source(src), mode(m),
+          dist(new int[count]), pred(new int[count]), predEdge(new int[count])
+    {
+        for (int v = 0; v < n; v++) {
+            dist[v] = INT_MAX;
+            pred[v] = -1;
+            predEdge[v] = -1;
+        }
+    }
+
+    ShortestPathTree(const ShortestPathTree&) = delete;
+    ShortestPathTree& operator=(const ShortestPathTree&) = delete;
+
+    ~ShortestPathTree() {
+        delete[] dist;
+        delete[] pred;
+        delete[] predEdge;
+    }
+
+    bool reached(int v) const { return dist[v] != INT_MAX; }
+};
+
+//
+// ─── DELTA-STEPPING SSSP ───────────────────────────────────────────────
+//
+// Meyer & Sanders' bucketed Dijkstra. Tentative distances are grouped in
+// buckets of width delta; all vertices of the lowest bucket are relaxed
+// at once across the pool. Light edges (weight <= delta) can refill the
+// current bucket and are relaxed until it drains, heavy edges are relaxed
+// once per bucket afterwards.
+//
+// Each vertex keeps (dist, predEdge) packed into one 64-bit word and is
+// lowered with a compare-and-swap, so concurrent relaxations never tear
+// and ties go to the lower edge id — the tree is the same for any number
+// of threads.
+//
+class DeltaStepping {
+    const FlatGraph& graph;
+    ThreadPool& pool;
+
+    static uint64_t pack(int dist, int edge) {
+        return ((uint64_t)(uint32_t)dist << 32) | (uint32_t)edge;
+    }
+    static int distOf(uint64_t word) { return (int)(word >> 32); }
+    static int edgeOf(uint64_t word) { return (int)(uint32_t)word; }
+
+    // Lowers `slot` to (dist, edge) if that is an improvement.
+    static bool relax(std::atomic<uint64_t>& slot, int dist, int edge) {
+        uint64_t want = pack(dist, edge);
+        uint64_t cur = slot.load(std::memory_order_relaxed);
+
+        while (want < cur) {
+            if (slot.compare_exchange_weak(cur, want, std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+
+public:
+    DeltaStepping(const FlatGraph& g, ThreadPool& p) : graph(g), pool(p) {}
+
+    // Mean edge weight: a bucket then holds roughly one hop's worth of
+    // cost, which keeps phases short without making buckets too sparse.
+    int defaultDelta(WeightMode mode) const {
+        if (graph.m == 0) return 1;
+
+        const int* w = graph.weights(mode);
+        long long total = 0;
+        for (int e = 0; e < graph.m; e++)
+            total += w[e];
+
+        int delta = (int)(total / graph.m);
+        return delta > 0 ? delta : 1;
+    }
+
+    ShortestPathTree* run(int source, WeightMode mode, int delta = 0) {
+        if (delta <= 0)
+            delta = defaultDelta(mode);
+
+        int n = graph.n;
+        const int* w = graph.weights(mode);
+        int threads = pool.size();
+
+        std::atomic<uint64_t>* best = new std::atomic<uint64_t>[n];
+        for (int v = 0; v < n; v++)
+            best[v].store(pack(INT_MAX, -1), std::memory_order_relaxed);
+        best[source].store(pack(0, -1), std::memory_order_relaxed);
+
+        // queued[v] / settled[v] hold the phase / bucket that last took v,
+        // which dedupes the buckets without clearing anything between them.
+        int* queued = new int[n];
+        int* settled = new int[n];
+        for (int v = 0; v < n; v++) {
+            queued[v] = -1;
+            settled[v] = -1;
+        }
+
+        ArrayList<ArrayList<int>> buckets;
+        ArrayList<int>* improved = new ArrayList<int>[threads];
+
+        auto place = [&](int v) {
+            int b = distOf(best[v].load(std::memory_order_relaxed)) / delta;
+            while (buckets.size() <= b)
+                buckets.append(ArrayList<int>());
+            buckets[b].append(v);
+        };
+
+        auto collect = [&]() {
+            for (int t = 0; t < threads; t++) {
+                for (int i = 0; i < improved[t].size(); i++)
+                    place(improved[t][i]);
+                improved[t] = ArrayList<int>();
+            }
+        };
+
+        auto relaxEdges = [&](ArrayList<int>& from, bool light) {
+            pool.parallelFor(0, from.size(), [&](int i, int worker) {
+                int u = from[i];
+                int du = distOf(best[u].load(std::memory_order_relaxed));
+
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                    if ((w[e] <= delta) != light) continue;
+
+                    int v = graph.targets[e];
+                    if (relax(best[v], du + w[e], e))
+                        improved[worker].append(v);
+                }
+            }, 16);
+        };
+
+        place(source);
+
+        int phase = 0;
+        for (int b = 0; b < buckets.size(); b++) {
+            ArrayList<int> reached;
+
+            while (buckets[b].size() > 0) {
+                ArrayList<int> frontier;
+                for (int i = 0; i < buckets[b].size(); i++) {
+                    int v = buckets[b][i];
+                    int dv = distOf(best[v].load(std::memory_order_relaxed));
+                    if (dv / delta != b || queued[v] == phase) continue;
+
+                    queued[v] = phase;
+                    frontier.append(v);
+                    if (settled[v] != b) {
+                        settled[v] = b;
+                        reached.append(v);
+                    }
+                }
+                buckets[b] = ArrayList<int>();
+                phase++;
+
+                relaxEdges(frontier, true);
+                collect();
+            }
+
+            relaxEdges(reached, false);
+            collect();
+        }
+
+        ShortestPathTree* tree = new ShortestPathTree(n, source, mode);
+        for (int v = 0; v < n; v++) {
+            uint64_t word = best[v].load(std::memory_order_relaxed);
+            tree->dist[v] = distOf(word);
+            tree->predEdge[v] = edgeOf(word);
+            if (tree->predEdge[v] >= 0)
+                tree->pred[v] = graph.edgeSource(tree->predEdge[v]);
+        }
+
+        delete[] best;
+        delete[] queued;
+        delete[] settled;
+        delete[] improved;
+
+        return tree;
+    }
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include <FlatGraph.h>
+#include <MinHeap.h>
+#include <climits>
+
+//
+// ─── POINT-TO-POINT DIJKSTRA ───────────────────────────────────────────
+//
+// Sequential Dijkstra over a FlatGraph with an indexed heap. Scratch
+// arrays are sized once and reset lazily with a query stamp, so a query
+// only pays for the vertices it touches. One object per thread: queries
+// on the same object must not overlap.
+//
+// The set-to-set queries behave as if a virtual source joined every
+// start at cost zero and every target joined a virtual sink: all starts
+// seed the heap together and the first target settled wins, so "any of
+// these airports to any of those" is one search instead of one per pair.
+//
+class Dijkstra {
+    const FlatGraph& graph;
+    MinHeap heap;
+    int* dist;
+    int* predEdge;
+    int* stamp;
+    int* target;    // == current for the targets of a set-to-set query
+    int current;
+
+    int distance(int v) const { return stamp[v] == current ? dist[v] : INT_MAX; }
+
+    // Settles vertices from the seeded heap until one with
+    // target[v] == current comes out. Unit weights when w is null.
+    int settleFirstTarget(const int* w, SearchStats& stats, SearchControl* control) {
+        while (!heap.isEmpty()) {
+            if (control && control->check(stats.nodesExpanded))
+                return -1;
+            if (heap.size() > stats.peakFrontier)
+                stats.peakFrontier = heap.size();
+
+            int u = heap.pop();
+            if (target[u] == current) return u;
+            stats.nodesExpanded++;
+
+            int du = dist[u];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                int dv = du + (w ? w[e] : 1);
+                stats.edgesRelaxed++;
+                if (dv < distance(v)) {
+                    dist[v] = dv;
+                    predEdge[v] = e;
+                    stamp[v] = current;
+                    heap.push(v, dv);
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Flat edge ids from the start that reached `v` (predEdge -1) to v.
+    void extract(int v, ArrayList<int>* path, ArrayList<int>* legs) const {
+        ArrayList<int> reversed;
+        for (; predEdge[v] >= 0; v = graph.edgeSource(predEdge[v]))
+            reversed.append(predEdge[v]);
+
+        if (path) {
+            *path = ArrayList<int>();
+            path->append(v);
+            for (int i = reversed.size() - 1; i >= 0; i--)
+                path->append(graph.targets[reversed[i]]);
+        }
+        if (legs) {
+            *legs = ArrayList<int>();
+            for (int i = reversed.size() - 1; i >= 0; i--)
+                legs->append(reversed[i]);
+        }
+    }
+
+    Route routeAny(const ArrayList<int>& sources, const ArrayList<int>& targets,
+                   const int* w, SearchControl* control) {
+        auto started = std::chrono::steady_clock::now();
+        Route result;
+        current++;
+        heap.clear();
+
+        for (int i = 0; i < targets.size(); i++)
+            target[targets[i]] = current;
+        for (int i = 0; i < sources.size(); i++) {
+            int s = sources[i];
+            dist[s] = 0;
+            predEdge[s] = -1;
+            stamp[s] = current;
+            heap.push(s, 0);
+        }
+
+        int reached = settleFirstTarget(w, result.stats, control);
+        result.stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (reached >= 0) {
+            ArrayList<int> edges;
+            extract(reached, &result.vertices, &edges);
+            graph.setLegs(result, edges);
+        }
+        result.stats.extractMs = millisSince(extracting);
+        return result;
+    }
+
+public:
+    explicit Dijkstra(const FlatGraph& g)
+        : graph(g), heap(g.n), dist(new int[g.n]), predEdge(new int[g.n]),
+          stamp(new int[g.n]), target(new int[g.n]), current(0)
+    {
+        for (int v = 0; v < g.n; v++)
+            stamp[v] = target[v] = 0;
+    }
+
+    Dijkstra(const Dijkstra&) = delete;
+    Dijkstra& operator=(const Dijkstra&) = delete;
+
+    ~Dijkstra() {
+        delete[] dist;
+        delete[] predEdge;
+        delete[] stamp;
+        delete[] target;
+    }
+
+    // Cheapest cost from source to dest (INT_MAX if unreachable). When
+    // `path` is given it receives the vertex ids from source to dest, and
+    // `legs` the flat edge id of each hop.
+    int query(int source, int dest, WeightMode mode,
+              ArrayList<int>* path = nullptr, ArrayList<int>* legs = nullptr) {
+        const int* w = graph.weights(mode);
+        current++;
+        heap.clear();
+
+        dist[source] = 0;
+        predEdge[source] = -1;
+        stamp[source] = current;
+        heap.push(source, 0);
+
+        while (!heap.isEmpty()) {
+            int u = heap.pop();
+            if (u == dest) break;
+
+            int du = dist[u];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                int dv = du + w[e];
+                if (dv < distance(v)) {
+                    dist[v] = dv;
+                    predEdge[v] = e;
+                    stamp[v] = current;
+                    heap.push(v, dv);
+                }
+            }
+        }
+
+        int cost = distance(dest);
+        if (cost != INT_MAX && (path || legs))
+            extract(dest, path, legs);
+        return cost;
+    }
+
+    Route route(int source, int dest, WeightMode mode) {
+        auto started = std::chrono::steady_clock::now();
+        Route result;
+        ArrayList<int> edges;
+        query(source, dest, mode, &result.vertices, &edges);
+        if (result.found())
+            graph.setLegs(result, edges);
+        result.stats.searchMs = millisSince(started);
+        return result;
+    }
+
+    // Cheapest route from any of `sources` to whichever of `targets` is
+    // closest. A vertex in both sets is a route of its own.
+    Route route(const ArrayList<int>& sources, const ArrayList<int>& targets,
+                WeightMode mode, SearchControl* control = nullptr) {
+        return routeAny(sources, targets, graph.weights(mode), control);
+    }
+
+    // Same with every flight costing one: fewest stops.
+    Route fewestStops(const ArrayList<int>& sources, const ArrayList<int>& targets,
+                      SearchControl* control = nullptr) {
+        return routeAny(sources, targets, nullptr, control);
+    }
+};
+
+#endif
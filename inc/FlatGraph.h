@@ -0,0 +1,114 @@
+#ifndef FLAT_GRAPH_H
+#define FLAT_GRAPH_H
+
+#include <Graph.h>
+
+//
+// ─── FLAT GRAPH (CSR SNAPSHOT) ─────────────────────────────────────────
+//
+// Read-only copy of a Graph laid out as compressed sparse rows: the
+// out-edges of vertex v are edges offsets[v] .. offsets[v + 1] - 1, kept
+// in the same order as v->edgeList. Vertex ids match Vertex::id, so
+// results map straight back to graph.vertices[id].
+//
+struct FlatGraph {
+    int n;
+    int m;
+    int* offsets;
+    int* targets;
+    int* price;
+    int* time;
+
+    FlatGraph()
+        : n(0), m(0), offsets(new int[1]), targets(nullptr),
+          price(nullptr), time(nullptr)
+    {
+        offsets[0] = 0;
+    }
+
+    // Empty arrays for `vertices` vertices and `edges` edges, for callers
+    // that fill the rows themselves.
+    FlatGraph(int vertices, int edges)
+        : n(vertices), m(edges), offsets(new int[vertices + 1]),
+          targets(new int[edges]), price(new int[edges]), time(new int[edges])
+    {
+        offsets[0] = 0;
+    }
+
+    explicit FlatGraph(const Graph& g)
+        : n(g.vertices.size()), m(0)
+    {
+        offsets = new int[n + 1];
+        offsets[0] = 0;
+        for (int v = 0; v < n; v++)
+            offsets[v + 1] = offsets[v] + g.vertices[v]->edgeList.size();
+
+        m = offsets[n];
+        targets = new int[m];
+        price = new int[m];
+        time = new int[m];
+
+        for (int v = 0; v < n; v++) {
+            const ArrayList<Edge*>& edges = g.vertices[v]->edgeList;
+            for (int j = 0; j < edges.size(); j++) {
+                int e = offsets[v] + j;
+                targets[e] = edges[j]->to->id;
+                price[e] = edges[j]->price;
+                time[e] = edges[j]->time;
+            }
+        }
+    }
+
+    FlatGraph(const FlatGraph&) = delete;
+    FlatGraph& operator=(const FlatGraph&) = delete;
+
+    ~FlatGraph() {
+        delete[] offsets;
+        delete[] targets;
+        delete[] price;
+        delete[] time;
+    }
+
+    int degree(int v) const { return offsets[v + 1] - offsets[v]; }
+
+    int weight(int e, WeightMode mode) const {
+        return mode == USE_PRICE ? price[e] : time[e];
+    }
+
+    const int* weights(WeightMode mode) const {
+        return mode == USE_PRICE ? price : time;
+    }
+
+    // Fills a Route's legs and totals from flat edge ids along its path.
+    void setLegs(Route& route, const ArrayList<int>& edges) const {
+        route.legs = ArrayList<int>();
+        for (int i = 0; i < edges.size(); i++)
+            route.legs.append(edges[i] - offsets[route.vertices[i]]);
+        finishRoute(route);
+    }
+
+    // Totals of a Route whose vertices and legs are already set.
+    void finishRoute(Route& route) const {
+        route.totalPrice = 0;
+        route.totalTime = 0;
+        for (int i = 0; i < route.legs.size(); i++) {
+            int e = offsets[route.vertices[i]] + route.legs[i];
+            route.totalPrice += price[e];
+            route.totalTime += time[e];
+        }
+        route.stops = route.vertices.size() > 1 ? route.vertices.size() - 2 : 0;
+    }
+
+    // Tail vertex of edge e (binary search over the offsets).
+    int edgeSource(int e) const {
+        int lo = 0, hi = n;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            if (offsets[mid] <= e) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+};
+
+#endif
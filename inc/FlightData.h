@@ -0,0 +1,220 @@
+#ifndef FLIGHT_DATA_H
+#define FLIGHT_DATA_H
+
+#include <BudgetSearch.h>
+#include <Dijkstra.h>
+#include <GraphLoader.h>
+#include <ParallelBFS.h>
+#include <QueryLog.h>
+#include <SearchTreeCache.h>
+#include <Snapshot.h>
+#include <TraceProfiler.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+
+//
+// ─── FLIGHT DATA ───────────────────────────────────────────────────────
+//
+// One version of the network and the engines built over it. Never
+// changed once loaded: a reload builds a whole new FlightData and
+// publishes it through a SnapshotStore, so a search can run on the
+// version it started with while the next one is being built. The
+// engines keep per-search scratch, so only one thread searches a given
+// FlightData at a time (the app's SearchWorker).
+//
+struct FlightData {
+    Graph g;
+    FlatGraph* flat;
+    DirectionOptimizingBFS* fewestStops;
+    SearchTreeCache* cheapest;
+    BudgetSearch* within;
+    Dijkstra* anyToAny;
+    uint64_t fingerprint;   // of the airports, for the query log
+    bool complete;          // both files loaded
+
+    FlightData()
+        : flat(nullptr), fewestStops(nullptr), cheapest(nullptr), within(nullptr),
+          anyToAny(nullptr), fingerprint(0), complete(false) {}
+
+    FlightData(const FlightData&) = delete;
+    FlightData& operator=(const FlightData&) = delete;
+
+    ~FlightData() {
+        delete anyToAny;
+        delete within;
+        delete cheapest;
+        delete fewestStops;
+        delete flat;
+    }
+};
+
+// Loads both CSVs and builds the engines. Always returns data (the
+// caller's to delete): like the app has always done, a file that cannot
+// be read leaves the network without airports or without flights, and
+// `complete` says whether that happened. fewestStops runs on `pool`,
+// which must outlive the data. Edges are parsed on `loader` if given,
+// so a reload need not queue up behind searches on `pool`.
+inline FlightData* loadFlightData(const std::string& vertices, const std::string& edges,
+                                  ThreadPool& pool, ThreadPool* loader = nullptr) {
+    TRACE_SCOPE("loadFlightData");
+    FlightData* data = new FlightData();
+    bool airports = loadAirportsCSV(data->g, vertices);
+    data->flat = loadEdgesCSVParallel(data->g, edges, loader ? *loader : pool);
+    data->complete = airports && data->flat != nullptr;
+    data->fingerprint = networkFingerprint(data->g);
+
+    TRACE_SCOPE("build engines");
+    if (data->flat == nullptr)
+        data->flat = new FlatGraph(data->g);
+    data->fewestStops = new DirectionOptimizingBFS(*data->flat, pool);
+    data->cheapest = new SearchTreeCache(*data->flat);
+    data->within = new BudgetSearch(*data->flat);
+    data->anyToAny = new Dijkstra(*data->flat);
+    return data;
+}
+
+//
+// ─── DATA WATCHER ──────────────────────────────────────────────────────
+//
+// Background thread that polls the two CSVs and, when either changes,
+// loads a new FlightData and publishes it to the store. A change is only
+// picked up once the files have looked the same for two polls in a row,
+// so a file still being written is not read half way. Loads that fail
+// are not published (searches carry on with the last good version) and
+// are retried on the next change.
+//
+// Reloads parse on a pool of the watcher's own: ThreadPool runs one
+// job at a time, so sharing the searches' pool would hold up fewest-stops
+// searches at every parallelFor while a reload is running.
+//
+// After each publish `reloaded(context)` is called on the watcher
+// thread. Every poll also frees old versions no search holds any more.
+//
+class DataWatcher {
+    struct FileStamp {
+        long long modified;
+        long long size;
+
+        bool operator==(const FileStamp& other) const {
+            return modified == other.modified && size == other.size;
+        }
+    };
+
+    SnapshotStore<FlightData>& store;
+    std::string verticesFile;
+    std::string edgesFile;
+    ThreadPool& pool;       // for the engines' searches
+    ThreadPool loader;      // for parsing
+    void (*reloaded)(void*);
+    void* context;
+    int intervalMs;
+
+    FileStamp loaded[2];    // what the current version was read from
+    FileStamp changed[2];   // a change seen last poll, not loaded yet
+    bool waiting;
+
+    std::atomic<long> reloads;
+    std::atomic<long> failures;
+
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable wake;
+    bool stopping;
+
+    // Modification time (ns) and size; -1s if the file is missing.
+    static FileStamp stampOf(const std::string& filename) {
+        struct stat info;
+        if (stat(filename.c_str(), &info) != 0) return { -1, -1 };
+
+#ifdef __linux__
+        long long ns = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+#else
+        long long ns = (long long)info.st_mtime * 1000000000LL;
+#endif
+        return { ns, (long long)info.st_size };
+    }
+
+    void poll() {
+        FileStamp now[2] = { stampOf(verticesFile), stampOf(edgesFile) };
+        if (now[0] == loaded[0] && now[1] == loaded[1]) {
+            waiting = false;
+            return;
+        }
+
+        if (!waiting || !(now[0] == changed[0] && now[1] == changed[1])) {
+            changed[0] = now[0];
+            changed[1] = now[1];
+            waiting = true;
+            return;
+        }
+
+        waiting = false;
+        loaded[0] = now[0];
+        loaded[1] = now[1];
+
+        TRACE_SCOPE("reload flight data");
+        FlightData* data = loadFlightData(verticesFile, edgesFile, pool, &loader);
+        if (!data->complete) {
+            std::cerr << "ERROR: Reload failed, keeping the current flight data" << std::endl;
+            delete data;
+            failures++;
+            return;
+        }
+
+        store.publish(data);
+        reloads++;
+        if (reloaded) reloaded(context);
+    }
+
+    void loop() {
+        TraceProfiler::nameThread("data watcher");
+        std::unique_lock<std::mutex> guard(lock);
+        while (!stopping) {
+            wake.wait_for(guard, std::chrono::milliseconds(intervalMs));
+            if (stopping) return;
+
+            guard.unlock();
+            poll();
+            store.collect();
+            guard.lock();
+        }
+    }
+
+public:
+    // The store should already hold the version read from these files.
+    DataWatcher(SnapshotStore<FlightData>& data, const std::string& vertices,
+                const std::string& edges, ThreadPool& searches,
+                void (*onReload)(void*), void* ctx, int pollMs = 1000)
+        : store(data), verticesFile(vertices), edgesFile(edges), pool(searches),
+          reloaded(onReload), context(ctx), intervalMs(pollMs), waiting(false),
+          reloads(0), failures(0), stopping(false)
+    {
+        loaded[0] = stampOf(vertices);
+        loaded[1] = stampOf(edges);
+        thread = std::thread(&DataWatcher::loop, this);
+    }
+
+    DataWatcher(const DataWatcher&) = delete;
+    DataWatcher& operator=(const DataWatcher&) = delete;
+
+    // Waits for a reload in progress to finish.
+    ~DataWatcher() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+
+    long reloadCount() const { return reloads.load(); }
+    long failureCount() const { return failures.load(); }
+};
+
+#endif
@@ -8,6 +8,8 @@
 #include <Stack.h>
 #include <string>
 #include <ostream>
+#include <chrono>
+#include <atomic>
 
 //
 // ─── EDGE STRUCT ─────────────────────────────────────────────────────────
@@ -19,9 +21,10 @@ struct Edge {
     Vertex* to;
     int price;
     int time;
+    int twin;   // index of the opposite edge in to->edgeList
 
     Edge(Vertex* f, Vertex* t, int p, int tm)
-        : from(f), to(t), price(p), time(tm) {}
+        : from(f), to(t), price(p), time(tm), twin(-1) {}
 };
 
 //
@@ -30,8 +33,9 @@ struct Edge {
 struct Vertex {
     std::string data;
     ArrayList<Edge*> edgeList;
+    int id;     // position in Graph::vertices, assigned by addVertex
 
-    Vertex(std::string name) : data(name) {}
+    Vertex(std::string name) : data(name), id(-1) {}
 
     ~Vertex() {
         for (int i = 0; i < edgeList.size(); i++)
@@ -54,6 +58,7 @@ struct Waypoint {
 
     int partialCost;
     int edgeCost;
+    int edgeIndex;      // index in parent->vertex->edgeList, -1 at the root
     WeightMode mode;
 
     Waypoint(Vertex* v, WeightMode m)
@@ -62,6 +67,7 @@ struct Waypoint {
           children(),
           partialCost(0),
           edgeCost(0),
+          edgeIndex(-1),
           mode(m)
     {}
 
@@ -71,6 +77,7 @@ struct Waypoint {
 
             Waypoint* child = new Waypoint(e->to, mode);
             child->parent = this;
+            child->edgeIndex = i;
 
             child->edgeCost =
                 (mode == USE_PRICE ? e->price : e->time);
@@ -96,11 +103,75 @@ inline void deleteWaypointTree(Waypoint* wp) {
 }
 
 //
-// ─── SEARCH RESULT WRAPPER ────────────────────────────────────────────
+// ─── SEARCH STATISTICS ────────────────────────────────────────────────
 //
-struct SearchResult {
-    Waypoint* root;
-    Waypoint* goal;
+// Counters collected by every search. searchMs and extractMs (building
+// the Route) are filled by the search itself; renderMs by whoever shows
+// the route (Application::showResult).
+//
+struct SearchStats {
+    long nodesExpanded;
+    long edgesRelaxed;
+    long peakFrontier;
+    long waypointsAllocated;
+    long hashProbes;
+    bool cacheHit;      // answered from RouteCache, counters are all zero
+
+    double searchMs;
+    double extractMs;
+    double renderMs;
+
+    SearchStats()
+        : nodesExpanded(0), edgesRelaxed(0), peakFrontier(0),
+          waypointsAllocated(0), hashProbes(0), cacheHit(false),
+          searchMs(0), extractMs(0), renderMs(0)
+    {}
+};
+
+inline double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+//
+// ─── SEARCH CONTROL ───────────────────────────────────────────────────
+//
+// Shared between a search running on another thread and whoever started
+// it: setting `cancelled` makes the search give up at its next step
+// (returning no goal), and `expanded` tracks nodes expanded so far.
+//
+struct SearchControl {
+    std::atomic<bool> cancelled;
+    std::atomic<long> expanded;
+
+    SearchControl() : cancelled(false), expanded(0) {}
+
+    // True if the search should stop; also publishes its progress.
+    bool check(long nodesExpanded) {
+        expanded.store(nodesExpanded, std::memory_order_relaxed);
+        return cancelled.load(std::memory_order_relaxed);
+    }
+};
+
+//
+// ─── ROUTE ────────────────────────────────────────────────────────────
+//
+// Compact answer returned by every search. vertices holds Vertex::id
+// from start to destination (empty if there is no route). legs[i] is the
+// index of the edge taken from vertices[i] in that vertex's edgeList, so
+// showing a leg never has to scan adjacency lists again.
+//
+struct Route {
+    ArrayList<int> vertices;
+    ArrayList<int> legs;
+    int totalPrice;
+    int totalTime;
+    int stops;
+    SearchStats stats;
+
+    Route() : totalPrice(0), totalTime(0), stops(0) {}
+
+    bool found() const { return vertices.size() > 0; }
 };
 
 //
@@ -108,24 +179,103 @@ struct SearchResult {
 //
 struct Graph {
     ArrayList<Vertex*> vertices;
+    long version;   // bumped on every edge change, for caches
+
+    Graph() : version(0) {}
 
     ~Graph() {
         for (int i = 0; i < vertices.size(); i++)
             delete vertices[i];
     }
 
-    void addVertex(Vertex* v) { vertices.append(v); }
+    void addVertex(Vertex* v) {
+        v->id = vertices.size();
+        vertices.append(v);
+    }
 
     void addEdge(Vertex* a, Vertex* b, int price, int time) {
-        a->edgeList.append(new Edge(a, b, price, time));
-        b->edgeList.append(new Edge(b, a, price, time));
+        Edge* there = new Edge(a, b, price, time);
+        Edge* back = new Edge(b, a, price, time);
+
+        back->twin = a->edgeList.size();
+        a->edgeList.append(there);
+        there->twin = b->edgeList.size();
+        b->edgeList.append(back);
+
+        version++;
+    }
+
+    // Re-prices the route a <-> b (the first one, if there are several) in
+    // both directions. Returns false if there is no such edge.
+    bool setEdgeWeights(Vertex* a, Vertex* b, int price, int time) {
+        for (int i = 0; i < a->edgeList.size(); i++) {
+            Edge* e = a->edgeList[i];
+            if (e->to != b) continue;
+
+            Edge* back = b->edgeList[e->twin];
+            e->price = back->price = price;
+            e->time = back->time = time;
+
+            version++;
+            return true;
+        }
+        return false;
+    }
+
+    // Edge taken on leg i of a route.
+    Edge* leg(const Route& route, int i) const {
+        return vertices[route.vertices[i]]->edgeList[route.legs[i]];
+    }
+
+    // Fills route.legs-derived totals once vertices and legs are set.
+    void finishRoute(Route& route) const {
+        route.totalPrice = 0;
+        route.totalTime = 0;
+        for (int i = 0; i < route.legs.size(); i++) {
+            Edge* e = leg(route, i);
+            route.totalPrice += e->price;
+            route.totalTime += e->time;
+        }
+        route.stops = route.vertices.size() > 1 ? route.vertices.size() - 2 : 0;
+    }
+
+    // Turns the goal's parent chain into a Route. The Waypoint tree can be
+    // freed as soon as this returns.
+    Route routeTo(Waypoint* goal, const SearchStats& stats) const {
+        auto started = std::chrono::steady_clock::now();
+        Route route;
+        route.stats = stats;
+
+        if (goal) {
+            int hops = 0;
+            for (Waypoint* w = goal; w->parent; w = w->parent)
+                hops++;
+
+            for (int i = 0; i <= hops; i++) route.vertices.append(0);
+            for (int i = 0; i < hops; i++) route.legs.append(0);
+
+            int i = hops;
+            for (Waypoint* w = goal; w; w = w->parent, i--) {
+                route.vertices[i] = w->vertex->id;
+                if (w->parent)
+                    route.legs[i - 1] = w->edgeIndex;
+            }
+            finishRoute(route);
+        }
+
+        route.stats.extractMs = millisSince(started);
+        return route;
     }
 
     //
     // ─── BFS FOR FEWEST STOPS ──────────────────────────────────────────
     //
-    SearchResult bfs(Vertex* start, Vertex* dest) {
+    Route bfs(Vertex* start, Vertex* dest, SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
         Waypoint* root = new Waypoint(start, USE_PRICE);
+        Waypoint* goal = nullptr;
+        SearchStats stats;
+        stats.waypointsAllocated = 1;
 
         Queue<Waypoint*> q;
         HashTable<std::string> seen;
@@ -133,27 +283,50 @@ struct Graph {
         seen.insert(start->data);
 
         while (!q.isEmpty()) {
+            if (q.size() > stats.peakFrontier)
+                stats.peakFrontier = q.size();
+
+            if (control && control->check(stats.nodesExpanded))
+                break;
+
             Waypoint* n = q.dequeue();
-            if (n->vertex == dest)
-                return { root, n };
+            if (n->vertex == dest) {
+                goal = n;
+                break;
+            }
 
             n->expand();
+            stats.nodesExpanded++;
+            stats.waypointsAllocated += n->children.size();
+
             for (int i = 0; i < n->children.size(); i++) {
                 Waypoint* c = n->children[i];
+                stats.edgesRelaxed++;
                 if (!seen.search(c->vertex->data)) {
                     q.enqueue(c);
                     seen.insert(c->vertex->data);
                 }
             }
         }
-        return { root, nullptr };
+
+        stats.hashProbes = seen.getProbes();
+        stats.searchMs = millisSince(started);
+
+        Route route = routeTo(goal, stats);
+        deleteWaypointTree(root);
+        return route;
     }
 
     //
     // ─── UCS (DIJKSTRA) ────────────────────────────────────────────────
     //
-    SearchResult ucs(Vertex* start, Vertex* dest, WeightMode mode) {
+    Route ucs(Vertex* start, Vertex* dest, WeightMode mode,
+              SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
         Waypoint* root = new Waypoint(start, mode);
+        Waypoint* goal = nullptr;
+        SearchStats stats;
+        stats.waypointsAllocated = 1;
 
         ArrayList<Waypoint*> frontier;
         HashTable<std::string> visited;
@@ -161,20 +334,30 @@ struct Graph {
         frontier.append(root);
 
         while (frontier.size() > 0) {
+            if (frontier.size() > stats.peakFrontier)
+                stats.peakFrontier = frontier.size();
+
+            if (control && control->check(stats.nodesExpanded))
+                break;
 
             // pop smallest cost
             Waypoint* node = frontier[0];
             frontier.removeFirst();
 
-            if (node->vertex == dest)
-                return { root, node };
+            if (node->vertex == dest) {
+                goal = node;
+                break;
+            }
 
             visited.insert(node->vertex->data);
 
             node->expand();
+            stats.nodesExpanded++;
+            stats.waypointsAllocated += node->children.size();
 
             for (int i = 0; i < node->children.size(); i++) {
                 Waypoint* c = node->children[i];
+                stats.edgesRelaxed++;
 
                 if (visited.search(c->vertex->data))
                     continue;
@@ -194,7 +377,13 @@ struct Graph {
                 }
             }
         }
-        return { root, nullptr };
+
+        stats.hashProbes = visited.getProbes();
+        stats.searchMs = millisSince(started);
+
+        Route route = routeTo(goal, stats);
+        deleteWaypointTree(root);
+        return route;
     }
 };
 
@@ -0,0 +1,141 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include <Graph.h>
+#include <cstdint>
+#include <string>
+
+//
+// ─── RANDOM NUMBERS ────────────────────────────────────────────────────
+//
+// Small xorshift generator so synthetic graphs are reproducible from a
+// seed on every platform (and <random> is off limits).
+//
+struct Random {
+    uint64_t state;
+
+    Random(uint64_t seed = 88172645463325252ULL)
+        : state(seed ? seed : 88172645463325252ULL) {}
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Uniform in [lo, hi].
+    int between(int lo, int hi) {
+        return lo + (int)(next() % (uint64_t)(hi - lo + 1));
+    }
+};
+
+//
+// ─── SYNTHETIC AIRLINE NETWORK ─────────────────────────────────────────
+//
+// Fills `g` with `count` airports and about count * degree / 2 routes.
+// A random spanning tree keeps everything connected; the remaining
+// routes attach to a few hub airports half of the time, which gives the
+// skewed degree distribution real airline networks have. Prices and
+// times are loosely correlated, like the ones in assets/edges.csv.
+//
+inline void generateGraph(Graph& g, int count, int degree, uint64_t seed = 1) {
+    Random rng(seed);
+
+    for (int i = 0; i < count; i++)
+        g.addVertex(new Vertex("V" + std::to_string(i)));
+
+    int hubs = 1;
+    while (hubs * hubs < count) hubs++;
+
+    int routes = count * degree / 2;
+    for (int i = 0; i < routes; i++) {
+        int a, b;
+        if (i < count - 1) {
+            a = i + 1;
+            b = rng.between(0, i);
+        } else {
+            a = rng.between(0, count - 1);
+            b = rng.between(0, 1) ? rng.between(0, hubs - 1)
+                                  : rng.between(0, count - 1);
+            if (a == b) continue;
+        }
+
+        int price = rng.between(50, 1000);
+        int time = price / 2 + rng.between(30, 400);
+
+        g.addEdge(g.vertices[a], g.vertices[b], price, time);
+    }
+}
+
+//
+// ─── REGIONAL AIRLINE NETWORK ──────────────────────────────────────────
+//
+// Same size and prices as generateGraph, but airports belong to one of
+// `regions` regions (consecutive ids) and most routes stay inside their
+// region, half of them to its hubs. One route in ten links hubs of two
+// regions, so regions only meet at hub airports, as domestic networks
+// meet at international gateways. Graphs like this have small cuts,
+// which is what partitioning needs; generateGraph's do not.
+//
+inline void generateRegionalGraph(Graph& g, int count, int degree, int regions,
+                                  uint64_t seed = 1) {
+    Random rng(seed);
+
+    for (int i = 0; i < count; i++)
+        g.addVertex(new Vertex("V" + std::to_string(i)));
+
+    if (regions < 1) regions = 1;
+    if (regions > count) regions = count;
+    auto first = [&](int r) { return (int)((long)count * r / regions); };
+    auto regionOf = [&](int v) {
+        int r = (int)((long)v * regions / count);
+        while (first(r + 1) <= v) r++;
+        while (first(r) > v) r--;
+        return r;
+    };
+
+    // A region's first sqrt(size) airports are its hubs.
+    auto hubs = [&](int r) {
+        int size = first(r + 1) - first(r);
+        int h = 1;
+        while (h * h < size) h++;
+        return h;
+    };
+
+    int routes = count * degree / 2;
+    for (int i = 0; i < routes; i++) {
+        int a, b;
+        if (i < count - 1) {
+            // Spanning tree: inside the region, except that each region's
+            // first airport joins a hub of an earlier region.
+            a = i + 1;
+            int r = regionOf(a);
+            if (a == first(r)) {
+                int other = rng.between(0, r - 1);
+                b = first(other) + rng.between(0, hubs(other) - 1);
+            } else {
+                b = rng.between(first(r), a - 1);
+            }
+        } else if (rng.between(0, 9) == 0) {
+            int r = rng.between(0, regions - 1);
+            int s = rng.between(0, regions - 1);
+            a = first(r) + rng.between(0, hubs(r) - 1);
+            b = first(s) + rng.between(0, hubs(s) - 1);
+        } else {
+            int r = rng.between(0, regions - 1);
+            int end = first(r + 1) - 1;
+            a = rng.between(first(r), end);
+            b = rng.between(0, 1) ? first(r) + rng.between(0, hubs(r) - 1)
+                                  : rng.between(first(r), end);
+        }
+        if (a == b) continue;
+
+        int price = rng.between(50, 1000);
+        int time = price / 2 + rng.between(30, 400);
+
+        g.addEdge(g.vertices[a], g.vertices[b], price, time);
+    }
+}
+
+#endif
@@ -0,0 +1,342 @@
+#ifndef GRAPH_LOADER_H
+#define GRAPH_LOADER_H
+
+#include <FlatGraph.h>
+#include <Graph.h>
+#include <ThreadPool.h>
+#include <TraceProfiler.h>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+
+//
+// ─── CSV LOADING ───────────────────────────────────────────────────────
+//
+// assets/vertices.csv holds one airport name per line; line i becomes
+// vertex i. assets/edges.csv holds "from,to,price,time" per line, using
+// those vertex indices. Shared by the app and the command-line tools.
+//
+inline bool loadAirportsCSV(Graph& g, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Cannot open vertices CSV: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (getline(file, line)) {
+        if (line.size() == 0) continue;
+
+        g.addVertex(new Vertex(line));
+    }
+
+    file.close();
+    return true;
+}
+
+inline bool loadEdgesCSV(Graph& g, const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Cannot open edges CSV: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (getline(file, line)) {
+        if (line.size() == 0) continue;
+
+        std::string a, b, c, d;
+        std::stringstream ss(line);
+
+        getline(ss, a, ',');
+        getline(ss, b, ',');
+        getline(ss, c, ',');
+        getline(ss, d, ',');
+
+        int from = stoi(a);
+        int to   = stoi(b);
+        int price = stoi(c);
+        int time  = stoi(d);
+
+        g.addEdge(g.vertices[from], g.vertices[to], price, time);
+    }
+
+    file.close();
+    return true;
+}
+
+//
+// ─── PARALLEL EDGE LOADING ─────────────────────────────────────────────
+//
+// Same input and result as loadEdgesCSV, for edge files too big to feed
+// through addEdge one line at a time. The file is read into memory in one
+// go and cut into line-aligned chunks, one per worker. Each worker parses
+// its chunk into its own EdgeRecord buffer and counts how many edge ends
+// the chunk gives every vertex. A pass over those counts turns them into
+// degrees plus, per chunk, its first slot in each vertex's row; after a
+// prefix sum over the degrees every chunk scatters its edges into a
+// FlatGraph, writing only slots it owns. Rows come out in file order, as
+// repeated addEdge calls would leave them, and the Graph's edgeLists are
+// then filled from the rows, one vertex per task.
+//
+// The per-chunk counts cost workers * vertices ints, which the edges
+// outweigh in any file worth loading this way.
+//
+struct EdgeRecord {
+    int from;
+    int to;
+    int price;
+    int time;
+};
+
+struct EdgeLoadStats {
+    long edges;         // lines loaded
+    int chunks;
+    double readMs;
+    double parseMs;     // parsing and per-chunk counts
+    double buildMs;     // prefix sum, scatter and edgeLists
+
+    EdgeLoadStats() : edges(0), chunks(0), readMs(0), parseMs(0), buildMs(0) {}
+};
+
+struct EdgeChunk {
+    const char* begin;
+    const char* end;
+    ArrayList<EdgeRecord> records;
+    int* ends;          // edge ends per vertex, then the chunk's first slot
+    long lines;
+    long badLine;       // first bad line, counted from the chunk start, or -1
+
+    EdgeChunk() : begin(nullptr), end(nullptr), ends(nullptr), lines(0), badLine(-1) {}
+};
+
+// Reads a decimal int at p, after any blanks, and moves p past it.
+inline bool parseCSVInt(const char*& p, const char* end, int& value) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) p++;
+    if (p == end || *p < '0' || *p > '9') return false;
+
+    long x = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        x = x * 10 + (*p - '0');
+        if (x > (long)INT_MAX + 1) return false;
+        p++;
+    }
+    if (negative) x = -x;
+    if (x > INT_MAX) return false;
+
+    value = (int)x;
+    return true;
+}
+
+inline bool skipCSVComma(const char*& p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    if (p == end || *p != ',') return false;
+    p++;
+    return true;
+}
+
+inline void parseEdgeChunk(EdgeChunk& chunk, int n) {
+    for (int v = 0; v < n; v++)
+        chunk.ends[v] = 0;
+
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const char* eol = static_cast<const char*>(memchr(p, '\n', chunk.end - p));
+        if (eol == nullptr) eol = chunk.end;
+        chunk.lines++;
+
+        const char* q = p;
+        while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+        if (q < eol) {
+            EdgeRecord r;
+            bool ok = parseCSVInt(q, eol, r.from) && skipCSVComma(q, eol)
+                   && parseCSVInt(q, eol, r.to) && skipCSVComma(q, eol)
+                   && parseCSVInt(q, eol, r.price) && skipCSVComma(q, eol)
+                   && parseCSVInt(q, eol, r.time)
+                   && r.from >= 0 && r.from < n && r.to >= 0 && r.to < n;
+
+            if (ok) {
+                chunk.records.append(r);
+                chunk.ends[r.from]++;
+                chunk.ends[r.to]++;
+            } else if (chunk.badLine < 0) {
+                chunk.badLine = chunk.lines - 1;
+            }
+        }
+        p = eol + 1;
+    }
+}
+
+// Adds the file's edges to g, which must have its vertices and no edges
+// yet, and returns the matching FlatGraph (the caller's to delete), or
+// nullptr with g untouched if the file cannot be read or a line is bad.
+inline FlatGraph* loadEdgesCSVParallel(Graph& g, const std::string& filename,
+                                       ThreadPool& pool, EdgeLoadStats* stats = nullptr) {
+    TRACE_SCOPE("loadEdgesCSVParallel");
+    auto started = std::chrono::steady_clock::now();
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Cannot open edges CSV: " << filename << std::endl;
+        return nullptr;
+    }
+
+    // Sized with a seek, which a directory or pipe answers with nonsense.
+    struct stat info;
+    bool regular = stat(filename.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+    file.seekg(0, std::ios::end);
+    long size = (long)file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (!regular || size < 0) {
+        std::cerr << "ERROR: Cannot read edges CSV: " << filename << std::endl;
+        return nullptr;
+    }
+
+    char* text = new char[size > 0 ? size : 1];
+    file.read(text, size);
+    bool whole = file.gcount() == size;
+    file.close();
+    if (!whole) {
+        std::cerr << "ERROR: Cannot read edges CSV: " << filename << std::endl;
+        delete[] text;
+        return nullptr;
+    }
+    double readMs = millisSince(started);
+
+    // One chunk per worker (small files stay whole), each starting on a
+    // line of its own.
+    auto parsing = std::chrono::steady_clock::now();
+    int n = g.vertices.size();
+    long perChunk = 1L << 16;
+    int k = size / perChunk < pool.size() ? (int)(size / perChunk) : pool.size();
+    if (k < 1) k = 1;
+
+    EdgeChunk* chunks = new EdgeChunk[k];
+    int* ends = new int[(long)k * n > 0 ? (long)k * n : 1];
+    long start = 0;
+    for (int c = 0; c < k; c++) {
+        long cut = size * c / k;
+        if (cut < start) cut = start;
+        while (cut > 0 && cut < size && text[cut - 1] != '\n') cut++;
+
+        chunks[c].begin = text + cut;
+        chunks[c].ends = ends + (long)c * n;
+        if (c > 0) chunks[c - 1].end = text + cut;
+        start = cut;
+    }
+    chunks[k - 1].end = text + size;
+
+    pool.parallelFor(0, k, [&](int c, int) {
+        TRACE_SCOPE("parse edge chunk");
+        parseEdgeChunk(chunks[c], n);
+    }, 1);
+    delete[] text;
+
+    long records = 0, line = 0;
+    const char* problem = nullptr;
+    for (int c = 0; c < k; c++) {
+        if (chunks[c].badLine >= 0 && problem == nullptr) {
+            line += chunks[c].badLine + 1;
+            problem = "Bad edge on line ";
+        }
+        if (problem == nullptr) line += chunks[c].lines;
+        records += chunks[c].records.size();
+    }
+    if (problem == nullptr && 2 * records > INT_MAX) problem = "Too many edges, stopped at line ";
+
+    if (problem != nullptr) {
+        std::cerr << "ERROR: " << problem << line << " of " << filename << std::endl;
+        delete[] chunks;
+        delete[] ends;
+        return nullptr;
+    }
+    double parseMs = millisSince(parsing);
+
+    // Degrees, and each chunk's first slot in every row relative to the
+    // row start, in place of its counts.
+    auto building = std::chrono::steady_clock::now();
+    FlatGraph* flat = new FlatGraph(n, (int)(2 * records));
+    int* offsets = flat->offsets;
+    pool.parallelFor(0, n, [&](int v, int) {
+        int total = 0;
+        for (int c = 0; c < k; c++) {
+            int here = chunks[c].ends[v];
+            chunks[c].ends[v] = total;
+            total += here;
+        }
+        offsets[v + 1] = total;
+    }, 1024);
+
+    // Prefix sum over the degrees in k blocks: block totals, a serial scan
+    // over them, then every block again from its base.
+    int* base = new int[k + 1];
+    auto block = [&](int b) { return (int)((long)n * b / k); };
+    pool.parallelFor(0, k, [&](int b, int) {
+        int total = 0;
+        for (int v = block(b); v < block(b + 1); v++)
+            total += offsets[v + 1];
+        base[b + 1] = total;
+    }, 1);
+    base[0] = 0;
+    for (int b = 0; b < k; b++)
+        base[b + 1] += base[b];
+    pool.parallelFor(0, k, [&](int b, int) {
+        int running = base[b];
+        for (int v = block(b); v < block(b + 1); v++) {
+            running += offsets[v + 1];
+            offsets[v + 1] = running;
+        }
+    }, 1);
+    delete[] base;
+
+    int* twin = new int[flat->m > 0 ? flat->m : 1];
+    pool.parallelFor(0, k, [&](int c, int) {
+        TRACE_SCOPE("scatter edge chunk");
+        int* cursor = chunks[c].ends;
+        const ArrayList<EdgeRecord>& list = chunks[c].records;
+        for (int i = 0; i < list.size(); i++) {
+            const EdgeRecord& r = list[i];
+            int there = offsets[r.from] + cursor[r.from]++;
+            int back = offsets[r.to] + cursor[r.to]++;
+
+            flat->targets[there] = r.to;
+            flat->targets[back] = r.from;
+            flat->price[there] = flat->price[back] = r.price;
+            flat->time[there] = flat->time[back] = r.time;
+            twin[there] = back - offsets[r.to];
+            twin[back] = there - offsets[r.from];
+        }
+    }, 1);
+    delete[] chunks;
+    delete[] ends;
+
+    pool.parallelFor(0, n, [&](int v, int) {
+        Vertex* from = g.vertices[v];
+        from->edgeList.reserve(flat->degree(v));
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            Edge* edge = new Edge(from, g.vertices[flat->targets[e]],
+                                  flat->price[e], flat->time[e]);
+            edge->twin = twin[e];
+            from->edgeList.append(edge);
+        }
+    }, 256);
+    delete[] twin;
+    g.version += records;
+
+    if (stats) {
+        stats->edges = records;
+        stats->chunks = k;
+        stats->readMs = readMs;
+        stats->parseMs = parseMs;
+        stats->buildMs = millisSince(building);
+    }
+    return flat;
+}
+
+#endif
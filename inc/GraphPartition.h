@@ -0,0 +1,276 @@
+#ifndef GRAPH_PARTITION_H
+#define GRAPH_PARTITION_H
+
+#include <FlatGraph.h>
+#include <MinHeap.h>
+
+//
+// ─── PARTITION ─────────────────────────────────────────────────────────
+//
+// part[v] in [0, parts) for every vertex. cutEdges counts routes whose
+// two airports ended up in different parts (each once, not per
+// direction); a vertex with such a route is a boundary vertex.
+//
+struct Partition {
+    int n;
+    int parts;
+    int* part;
+    long cutEdges;
+
+    Partition(int vertices, int count)
+        : n(vertices), parts(count), part(new int[vertices]), cutEdges(0) {}
+
+    Partition(const Partition&) = delete;
+    Partition& operator=(const Partition&) = delete;
+
+    ~Partition() {
+        delete[] part;
+    }
+
+    int size(int p) const {
+        int count = 0;
+        for (int v = 0; v < n; v++)
+            if (part[v] == p) count++;
+        return count;
+    }
+
+    bool isBoundary(const FlatGraph& g, int v) const {
+        for (int e = g.offsets[v]; e < g.offsets[v + 1]; e++)
+            if (part[g.targets[e]] != part[v]) return true;
+        return false;
+    }
+
+    long countCut(const FlatGraph& g) const {
+        long arcs = 0;
+        for (int u = 0; u < g.n; u++)
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++)
+                if (part[g.targets[e]] != part[u]) arcs++;
+        return arcs / 2;
+    }
+};
+
+//
+// ─── RECURSIVE BISECTION ───────────────────────────────────────────────
+//
+// Splits the vertex set in two, then each half again, until there are
+// `parts` pieces of near-equal size (an odd count splits unevenly, in
+// proportion). Each bisection is greedy graph growing: starting from a
+// seed, side 0 repeatedly takes the frontier vertex whose move adds
+// least to the cut (routes leaving the region minus routes into it),
+// so hubs pull their spokes in and the region stops at a sparse seam.
+// A few seeds are tried (a pseudo-peripheral vertex and some spread
+// over the set) and the smallest cut kept, after a Kernighan-Lin style
+// clean-up: a vertex with more routes into the other side than into its
+// own moves across, as long as both sides stay within a few percent of
+// their target size. Edges leaving the set being split are ignored;
+// they were cut higher up.
+//
+// Expects a symmetric graph, as Graph::addEdge builds. O(m log n) per
+// seed and level.
+//
+class RecursiveBisection {
+    const FlatGraph& graph;
+    MinHeap heap;
+    int* mark;          // == current for vertices of the set being split
+    int* side;          // 0 or 1 within the current set
+    int* links;         // routes into side 0 while it grows
+    int* degree;        // routes inside the set
+    int* queue;
+    int current;
+
+    static const int SEEDS = 4;
+    static const int PASSES = 8;
+
+    bool inSet(int v) const { return mark[v] == current; }
+
+    // BFS over the set from `start`; returns the last vertex reached.
+    int farthest(int start, const int* set, int count) {
+        int stamp = current + 1;
+        int head = 0, tail = 0, next = 0;
+
+        mark[start] = stamp;
+        queue[tail++] = start;
+        while (head < count) {
+            if (head == tail) {
+                while (mark[set[next]] == stamp) next++;
+                mark[set[next]] = stamp;
+                queue[tail++] = set[next];
+            }
+
+            int u = queue[head++];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                if (!inSet(v)) continue;
+                mark[v] = stamp;
+                queue[tail++] = v;
+            }
+        }
+
+        for (int i = 0; i < count; i++) mark[set[i]] = current;
+        return queue[count - 1];
+    }
+
+    // Side 0 grown from `seed` to `leftCount` vertices; returns the cut.
+    long grow(int seed, const int* set, int count, int leftCount) {
+        for (int i = 0; i < count; i++) {
+            side[set[i]] = 1;
+            links[set[i]] = 0;
+        }
+        heap.clear();
+        heap.push(seed, degree[seed]);
+
+        int next = 0;
+        for (int taken = 0; taken < leftCount; taken++) {
+            if (heap.isEmpty()) {
+                // Set not connected: start again from anything left.
+                while (side[set[next]] == 0) next++;
+                heap.push(set[next], degree[set[next]]);
+            }
+
+            int u = heap.pop();
+            side[u] = 0;
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                if (!inSet(v) || side[v] == 0) continue;
+                links[v]++;
+                heap.push(v, degree[v] - 2 * links[v]);
+            }
+        }
+
+        refine(set, count, leftCount);
+        return cut(set, count);
+    }
+
+    void refine(const int* set, int count, int leftCount) {
+        int slack = count / 32 + 1;
+        int left = leftCount;
+        for (int pass = 0; pass < PASSES; pass++) {
+            int moved = 0;
+            for (int i = 0; i < count; i++) {
+                int u = set[i];
+                int same = 0, other = 0;
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                    int v = graph.targets[e];
+                    if (!inSet(v) || v == u) continue;
+                    if (side[v] == side[u]) same++;
+                    else other++;
+                }
+                if (other <= same) continue;
+
+                int after = side[u] == 0 ? left - 1 : left + 1;
+                if (after < leftCount - slack || after > leftCount + slack) continue;
+                if (after == 0 || after == count) continue;
+
+                side[u] = 1 - side[u];
+                left = after;
+                moved++;
+            }
+            if (moved == 0) break;
+        }
+    }
+
+    long cut(const int* set, int count) const {
+        long arcs = 0;
+        for (int i = 0; i < count; i++) {
+            int u = set[i];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+                if (inSet(graph.targets[e]) && side[graph.targets[e]] != side[u]) arcs++;
+        }
+        return arcs / 2;
+    }
+
+    // side[v] for every v in set, with about `leftCount` on side 0.
+    void bisect(const int* set, int count, int leftCount) {
+        current += 2;   // farthest() borrows current + 1
+        for (int i = 0; i < count; i++) mark[set[i]] = current;
+
+        for (int i = 0; i < count; i++) {
+            int u = set[i];
+            degree[u] = 0;
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+                if (inSet(graph.targets[e]) && graph.targets[e] != u) degree[u]++;
+        }
+
+        int seeds[SEEDS];
+        seeds[0] = farthest(farthest(set[0], set, count), set, count);
+        for (int k = 1; k < SEEDS; k++)
+            seeds[k] = set[(long)count * k / SEEDS];
+
+        int* best = new int[count];
+        long bestCut = -1;
+        for (int k = 0; k < SEEDS; k++) {
+            long c = grow(seeds[k], set, count, leftCount);
+            if (bestCut >= 0 && c >= bestCut) continue;
+            bestCut = c;
+            for (int i = 0; i < count; i++) best[i] = side[set[i]];
+        }
+        for (int i = 0; i < count; i++) side[set[i]] = best[i];
+        delete[] best;
+    }
+
+    void split(int* set, int count, int parts, int firstPart, int* part) {
+        if (parts == 1 || count <= 1) {
+            for (int i = 0; i < count; i++)
+                part[set[i]] = firstPart;
+            return;
+        }
+
+        int leftParts = parts / 2;
+        int leftCount = (int)((long)count * leftParts / parts);
+        if (leftCount == 0) leftCount = 1;
+        bisect(set, count, leftCount);
+
+        // Stable in-place split: side 0 first.
+        int* scratch = new int[count];
+        int left = 0, right = count;
+        for (int i = 0; i < count; i++) {
+            if (side[set[i]] == 0) scratch[left++] = set[i];
+            else scratch[--right] = set[i];
+        }
+        for (int i = 0; i < left; i++) set[i] = scratch[i];
+        for (int i = left; i < count; i++) set[i] = scratch[count - 1 - (i - left)];
+        delete[] scratch;
+
+        split(set, left, leftParts, firstPart, part);
+        split(set + left, count - left, parts - leftParts, firstPart + leftParts, part);
+    }
+
+public:
+    explicit RecursiveBisection(const FlatGraph& g)
+        : graph(g), heap(g.n > 0 ? g.n : 1), mark(new int[g.n]), side(new int[g.n]),
+          links(new int[g.n]), degree(new int[g.n]), queue(new int[g.n]), current(0)
+    {
+        for (int v = 0; v < g.n; v++)
+            mark[v] = 0;
+    }
+
+    RecursiveBisection(const RecursiveBisection&) = delete;
+    RecursiveBisection& operator=(const RecursiveBisection&) = delete;
+
+    ~RecursiveBisection() {
+        delete[] mark;
+        delete[] side;
+        delete[] links;
+        delete[] degree;
+        delete[] queue;
+    }
+
+    // Caller owns the result.
+    Partition* run(int parts) {
+        if (parts < 1) parts = 1;
+        if (parts > graph.n && graph.n > 0) parts = graph.n;
+
+        Partition* result = new Partition(graph.n, parts);
+        int* set = new int[graph.n > 0 ? graph.n : 1];
+        for (int v = 0; v < graph.n; v++)
+            set[v] = v;
+
+        split(set, graph.n, parts, 0, result->part);
+        delete[] set;
+
+        result->cutEdges = result->countCut(graph);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef GRAPH_REORDER_H
+#define GRAPH_REORDER_H
+
+#include <FlatGraph.h>
+#include <Sort.h>
+
+//
+// ─── REORDERED GRAPH ───────────────────────────────────────────────────
+//
+// A FlatGraph renumbered for cache locality. Vertex v of `graph` is
+// original vertex toOriginal[v] (Vertex::id in the source Graph), and
+// toLocal is the inverse. Each vertex keeps its edges in their original
+// order. Only the layout changes, so every search finds the same costs,
+// but one that breaks ties by edge id (DeltaStepping) may pick another
+// of several equally cheap routes.
+//
+struct ReorderedGraph {
+    FlatGraph* graph;
+    int* toOriginal;
+    int* toLocal;
+
+    ReorderedGraph(const FlatGraph& source, const int* order)
+        : toOriginal(new int[source.n]), toLocal(new int[source.n])
+    {
+        int n = source.n;
+        for (int v = 0; v < n; v++) {
+            toOriginal[v] = order[v];
+            toLocal[order[v]] = v;
+        }
+
+        graph = new FlatGraph(n, source.m);
+        for (int v = 0; v < n; v++)
+            graph->offsets[v + 1] = graph->offsets[v] + source.degree(order[v]);
+
+        for (int v = 0; v < n; v++) {
+            int e = graph->offsets[v];
+            for (int k = source.offsets[order[v]]; k < source.offsets[order[v] + 1]; k++, e++) {
+                graph->targets[e] = toLocal[source.targets[k]];
+                graph->price[e] = source.price[k];
+                graph->time[e] = source.time[k];
+            }
+        }
+    }
+
+    ReorderedGraph(const ReorderedGraph&) = delete;
+    ReorderedGraph& operator=(const ReorderedGraph&) = delete;
+
+    ~ReorderedGraph() {
+        delete graph;
+        delete[] toOriginal;
+        delete[] toLocal;
+    }
+
+    const std::string& name(const Graph& g, int v) const {
+        return g.vertices[toOriginal[v]]->data;
+    }
+};
+
+//
+// ─── REVERSE CUTHILL-MCKEE ORDER ───────────────────────────────────────
+//
+// BFS from a minimum-degree vertex of each component, visiting
+// neighbours by ascending degree, then reversed. Vertices that are close
+// in the graph end up close in memory, which is what the searches touch.
+//
+inline int* reverseCuthillMcKee(const FlatGraph& g) {
+    int n = g.n;
+    int* order = new int[n];
+    bool* placed = new bool[n];
+    for (int v = 0; v < n; v++) placed[v] = false;
+
+    // vertices by ascending degree, used to pick each component's root
+    int* byDegree = new int[n];
+    for (int v = 0; v < n; v++) byDegree[v] = v;
+    mergeSort(byDegree, n, [&](int a, int b) { return g.degree(a) < g.degree(b); });
+
+    int* scratch = new int[n];
+    int head = 0, tail = 0;
+
+    for (int r = 0; r < n; r++) {
+        int root = byDegree[r];
+        if (placed[root]) continue;
+
+        placed[root] = true;
+        order[tail++] = root;
+
+        while (head < tail) {
+            int u = order[head++];
+
+            int count = 0;
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                if (!placed[v]) {
+                    placed[v] = true;
+                    scratch[count++] = v;
+                }
+            }
+
+            mergeSort(scratch, count, [&](int a, int b) { return g.degree(a) < g.degree(b); });
+            for (int i = 0; i < count; i++)
+                order[tail++] = scratch[i];
+        }
+    }
+
+    for (int i = 0; i < n / 2; i++) {
+        int t = order[i];
+        order[i] = order[n - 1 - i];
+        order[n - 1 - i] = t;
+    }
+
+    delete[] placed;
+    delete[] byDegree;
+    delete[] scratch;
+    return order;
+}
+
+//
+// ─── HUB CLUSTERING ORDER ──────────────────────────────────────────────
+//
+// Vertices with above-average degree go first, busiest first, and the
+// rest keep their relative order. Hubs are on most routes, so packing
+// them together keeps their rows hot in cache.
+//
+inline int* hubClustering(const FlatGraph& g) {
+    int n = g.n;
+    int* order = new int[n];
+    for (int v = 0; v < n; v++) order[v] = v;
+
+    double average = n > 0 ? (double)g.m / n : 0;
+    mergeSort(order, n, [&](int a, int b) {
+        bool hubA = g.degree(a) > average, hubB = g.degree(b) > average;
+        if (hubA != hubB) return hubA;
+        return hubA && g.degree(a) > g.degree(b);
+    });
+
+    return order;
+}
+
+#endif
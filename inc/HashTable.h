@@ -16,6 +16,7 @@ class HashTable {
     ArrayList<ArrayList<T>> table;
     int capacity;
     int size;
+    long probes;    // bucket lookups + entries compared, for SearchStats
 
     int extractInt(int x) {
         return x;
@@ -99,6 +100,7 @@ public:
     HashTable(int k = 10) {
         capacity = k;
         size = 0;
+        probes = 0;
 
         for (int i = 0; i < k; i++) {
             table.append(ArrayList<T>());
@@ -109,15 +111,25 @@ public:
         int index = f(value);
         table[index].append(value);
         size++;
+        probes++;
 
         inflate();
     }
 
     bool search(T value) {
         int index = f(value);
-        return table[index].search(value);
+        ArrayList<T>& bucket = table[index];
+        probes++;
+
+        for (int i = 0; i < bucket.size(); i++) {
+            probes++;
+            if (bucket[i] == value) return true;
+        }
+        return false;
     }
 
+    long getProbes() const { return probes; }
+
     friend std::ostream &operator<< <>(std::ostream &os,
                                        const HashTable<T> &ht);
 
@@ -0,0 +1,401 @@
+#ifndef HUB_LABELS_H
+#define HUB_LABELS_H
+
+#include <FlatGraph.h>
+#include <MinHeap.h>
+#include <Sort.h>
+#include <climits>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+//
+// ─── HUB LABELS ────────────────────────────────────────────────────────
+//
+// 2-hop distance labels built by pruned Dijkstra (Akiba, Iwata &
+// Yoshida). Vertices are ranked by degree, hubs first. Every vertex v
+// gets a label: a list of (hub, dist(v, hub)) pairs sorted by hub rank,
+// such that for any s and t some hub on a shortest s-t route appears in
+// both labels. A query is then one merge of two short sorted arrays:
+//
+//   dist(s, t) = min over common hubs h of  dist(s, h) + dist(h, t)
+//
+// Each entry also records the next vertex from v towards the hub, so a
+// route can be rebuilt hop by hop (every vertex on that stretch has the
+// same hub in its label). There is one label set per weight mode.
+//
+// Labels are stored flat, CSR style: entries first[v] .. first[v + 1] - 1.
+//
+struct LabelSet {
+    int n;
+    long size;
+    long* first;
+    int* hub;       // hub rank
+    int* dist;
+    int* next;      // next vertex towards the hub (-1 at the hub itself)
+
+    LabelSet()
+        : n(0), size(0), first(new long[1]), hub(nullptr), dist(nullptr),
+          next(nullptr)
+    {
+        first[0] = 0;
+    }
+
+    LabelSet(const LabelSet&) = delete;
+    LabelSet& operator=(const LabelSet&) = delete;
+
+    ~LabelSet() {
+        delete[] first;
+        delete[] hub;
+        delete[] dist;
+        delete[] next;
+    }
+
+    void allocate(int vertices, long entries) {
+        delete[] first;
+        delete[] hub;
+        delete[] dist;
+        delete[] next;
+
+        n = vertices;
+        size = entries;
+        first = new long[n + 1];
+        hub = new int[size];
+        dist = new int[size];
+        next = new int[size];
+        first[0] = 0;
+    }
+
+    // Offsets run from 0 to size without going back, and every hub and
+    // next vertex is in range: what load() needs before trusting a file.
+    bool consistent() const {
+        if (first[0] != 0 || first[n] != size) return false;
+        for (int v = 0; v < n; v++)
+            if (first[v + 1] < first[v]) return false;
+        for (long k = 0; k < size; k++)
+            if (hub[k] < 0 || hub[k] >= n || next[k] < -1 || next[k] >= n) return false;
+        return true;
+    }
+
+    // Position of hub rank `h` in v's label, or -1.
+    long find(int v, int h) const {
+        long lo = first[v], hi = first[v + 1] - 1;
+        while (lo <= hi) {
+            long mid = (lo + hi) / 2;
+            if (hub[mid] == h) return mid;
+            if (hub[mid] < h) lo = mid + 1; else hi = mid - 1;
+        }
+        return -1;
+    }
+};
+
+class HubLabels {
+    int n;
+    int* order;     // order[rank] = vertex
+    LabelSet price;
+    LabelSet time;
+
+    static const uint32_t MAGIC = 0x31424c48;  // "HLB1"
+
+    const LabelSet& labels(WeightMode mode) const {
+        return mode == USE_PRICE ? price : time;
+    }
+
+    // Pruned Dijkstra from every vertex in rank order.
+    void build(const FlatGraph& graph, WeightMode mode, LabelSet& out) {
+        const int* w = graph.weights(mode);
+
+        ArrayList<int>* hubs = new ArrayList<int>[n];
+        ArrayList<int>* dists = new ArrayList<int>[n];
+        ArrayList<int>* nexts = new ArrayList<int>[n];
+
+        MinHeap heap(n);
+        int* tentative = new int[n];
+        int* via = new int[n];
+        int* hubDist = new int[n];      // by rank: dist(root, hub), or INT_MAX
+        ArrayList<int> touched;
+        for (int v = 0; v < n; v++) {
+            tentative[v] = INT_MAX;
+            hubDist[v] = INT_MAX;
+        }
+
+        for (int rank = 0; rank < n; rank++) {
+            int root = order[rank];
+            for (int i = 0; i < hubs[root].size(); i++)
+                hubDist[hubs[root][i]] = dists[root][i];
+
+            tentative[root] = 0;
+            via[root] = -1;
+            touched.append(root);
+            heap.push(root, 0);
+
+            while (!heap.isEmpty()) {
+                int u = heap.pop();
+                int du = tentative[u];
+
+                // Prune when the labels so far already cover root -> u.
+                bool covered = false;
+                for (int i = 0; i < hubs[u].size() && !covered; i++) {
+                    int d = hubDist[hubs[u][i]];
+                    if (d != INT_MAX && d + dists[u][i] <= du) covered = true;
+                }
+                if (covered) continue;
+
+                hubs[u].append(rank);
+                dists[u].append(du);
+                nexts[u].append(via[u]);
+
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                    int v = graph.targets[e];
+                    int dv = du + w[e];
+                    if (dv < tentative[v]) {
+                        if (tentative[v] == INT_MAX) touched.append(v);
+                        tentative[v] = dv;
+                        via[v] = u;
+                        heap.push(v, dv);
+                    }
+                }
+            }
+
+            for (int i = 0; i < touched.size(); i++)
+                tentative[touched[i]] = INT_MAX;
+            touched = ArrayList<int>();
+            for (int i = 0; i < hubs[root].size(); i++)
+                hubDist[hubs[root][i]] = INT_MAX;
+        }
+
+        long entries = 0;
+        for (int v = 0; v < n; v++)
+            entries += hubs[v].size();
+
+        out.allocate(n, entries);
+        for (int v = 0; v < n; v++) {
+            long at = out.first[v];
+            for (int i = 0; i < hubs[v].size(); i++) {
+                out.hub[at + i] = hubs[v][i];
+                out.dist[at + i] = dists[v][i];
+                out.next[at + i] = nexts[v][i];
+            }
+            out.first[v + 1] = at + hubs[v].size();
+        }
+
+        delete[] hubs;
+        delete[] dists;
+        delete[] nexts;
+        delete[] tentative;
+        delete[] via;
+        delete[] hubDist;
+    }
+
+    // Vertices from v to hub rank h, following the `next` pointers. False
+    // if they do not get there within n steps, which only a corrupt file
+    // can cause.
+    bool walk(const LabelSet& set, int v, int h, ArrayList<int>& path) const {
+        path.append(v);
+        for (int steps = 0; steps < n; steps++) {
+            long k = set.find(v, h);
+            if (k < 0) return false;
+            if (set.next[k] < 0) return v == order[h];
+            v = set.next[k];
+            path.append(v);
+        }
+        return false;
+    }
+
+    // Cheapest edge from u to v in this mode (there may be several).
+    static int edgeBetween(const FlatGraph& graph, int u, int v, WeightMode mode) {
+        int best = -1;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+            if (graph.targets[e] == v &&
+                (best < 0 || graph.weight(e, mode) < graph.weight(best, mode)))
+                best = e;
+        return best;
+    }
+
+    template <typename T>
+    static void put(std::ofstream& file, const T* data, long count) {
+        file.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    }
+
+    template <typename T>
+    static bool get(std::ifstream& file, T* data, long count) {
+        file.read(reinterpret_cast<char*>(data), count * sizeof(T));
+        return (bool)file;
+    }
+
+public:
+    HubLabels() : n(0), order(nullptr) {}
+
+    explicit HubLabels(const FlatGraph& graph) : n(graph.n) {
+        order = new int[n];
+        for (int v = 0; v < n; v++) order[v] = v;
+        mergeSort(order, n, [&](int a, int b) {
+            return graph.degree(a) > graph.degree(b) ||
+                   (graph.degree(a) == graph.degree(b) && a < b);
+        });
+
+        build(graph, USE_PRICE, price);
+        build(graph, USE_TIME, time);
+    }
+
+    HubLabels(const HubLabels&) = delete;
+    HubLabels& operator=(const HubLabels&) = delete;
+
+    ~HubLabels() {
+        delete[] order;
+    }
+
+    int vertexCount() const { return n; }
+
+    // Cheapest cost from s to t (INT_MAX if unreachable). `via` receives
+    // the rank of the meeting hub.
+    int distance(int s, int t, WeightMode mode, int* via = nullptr) const {
+        const LabelSet& set = labels(mode);
+        long i = set.first[s], iEnd = set.first[s + 1];
+        long j = set.first[t], jEnd = set.first[t + 1];
+
+        int best = INT_MAX, bestHub = -1;
+        while (i < iEnd && j < jEnd) {
+            if (set.hub[i] < set.hub[j]) {
+                i++;
+            } else if (set.hub[i] > set.hub[j]) {
+                j++;
+            } else {
+                int d = set.dist[i] + set.dist[j];
+                if (d < best) {
+                    best = d;
+                    bestHub = set.hub[i];
+                }
+                i++;
+                j++;
+            }
+        }
+
+        if (via) *via = bestHub;
+        return best;
+    }
+
+    // Full route, rebuilt from the labels: s up to the meeting hub, then
+    // the hub's stretch to t reversed. Not found if the labels do not
+    // describe a path of the graph.
+    Route route(const FlatGraph& graph, int s, int t, WeightMode mode) const {
+        auto started = std::chrono::steady_clock::now();
+        Route result;
+
+        int hub;
+        if (distance(s, t, mode, &hub) != INT_MAX) {
+            const LabelSet& set = labels(mode);
+            ArrayList<int> up, down, edges;
+            bool ok = walk(set, s, hub, up) && walk(set, t, hub, down);
+            for (int i = down.size() - 2; ok && i >= 0; i--)
+                up.append(down[i]);
+
+            for (int i = 0; ok && i + 1 < up.size(); i++) {
+                int e = edgeBetween(graph, up[i], up[i + 1], mode);
+                if (e < 0) ok = false;
+                edges.append(e);
+            }
+
+            if (ok) {
+                result.vertices = up;
+                graph.setLegs(result, edges);
+            }
+        }
+
+        result.stats.searchMs = millisSince(started);
+        return result;
+    }
+
+    long entries() const { return price.size + time.size; }
+
+    long bytes() const {
+        return n * sizeof(int)
+             + 2L * (n + 1) * sizeof(long)
+             + entries() * 3 * sizeof(int);
+    }
+
+    double averageLabel(WeightMode mode) const {
+        return n > 0 ? (double)labels(mode).size / n : 0;
+    }
+
+    // ─── SERIALIZATION ───
+    //
+    // Native-endian binary: magic, n, order, then for price and time the
+    // entry count, offsets, hubs, dists and next pointers.
+    //
+    bool save(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        uint32_t magic = MAGIC;
+        put(file, &magic, 1);
+        put(file, &n, 1);
+        put(file, order, n);
+
+        const LabelSet* sets[] = { &price, &time };
+        for (const LabelSet* set : sets) {
+            put(file, &set->size, 1);
+            put(file, set->first, n + 1);
+            put(file, set->hub, set->size);
+            put(file, set->dist, set->size);
+            put(file, set->next, set->size);
+        }
+        return (bool)file;
+    }
+
+    // Replaces the current labels. On failure (including a truncated or
+    // inconsistent file) the index is left empty.
+    bool load(const std::string& filename) {
+        delete[] order;
+        order = nullptr;
+        n = 0;
+        price.allocate(0, 0);
+        time.allocate(0, 0);
+
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        uint32_t magic;
+        int count;
+        if (!get(file, &magic, 1) || magic != MAGIC) return false;
+        if (!get(file, &count, 1) || count < 0) return false;
+
+        int* ranks = new int[count];
+        bool ok = get(file, ranks, count);
+
+        LabelSet* sets[] = { &price, &time };
+        for (LabelSet* set : sets) {
+            long size;
+            if (!ok || !get(file, &size, 1) || size < 0 || size > (long)count * count) {
+                ok = false;
+                break;
+            }
+            set->allocate(count, size);
+            ok = get(file, set->first, count + 1) && get(file, set->hub, size) &&
+                 get(file, set->dist, size) && get(file, set->next, size) &&
+                 set->consistent();
+        }
+        // order must be a permutation
+        bool* ranked = new bool[count > 0 ? count : 1];
+        for (int v = 0; v < count; v++)
+            ranked[v] = false;
+        for (int r = 0; ok && r < count; r++) {
+            if (ranks[r] < 0 || ranks[r] >= count || ranked[ranks[r]]) ok = false;
+            else ranked[ranks[r]] = true;
+        }
+        delete[] ranked;
+
+        if (!ok) {
+            delete[] ranks;
+            price.allocate(0, 0);
+            time.allocate(0, 0);
+            return false;
+        }
+
+        order = ranks;
+        n = count;
+        return true;
+    }
+};
+
+#endif
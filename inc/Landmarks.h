@@ -0,0 +1,321 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <DeltaStepping.h>
+#include <GraphGenerator.h>
+#include <MinHeap.h>
+#include <climits>
+
+//
+// ─── ALT LANDMARKS ─────────────────────────────────────────────────────
+//
+// Preprocessing for A* with landmarks and the triangle inequality
+// (Goldberg & Harrelson). For a landmark L and any vertices v, t:
+//
+//   dist(v, t) >= |dist(L, t) - dist(L, v)|
+//
+// (routes are undirected, so distances to and from L are the same). The
+// largest such bound over all landmarks is an admissible, consistent
+// heuristic for both price and time, with no coordinates needed.
+//
+// Landmarks are picked on price distances, either
+//   LANDMARKS_FARTHEST  each one as far as possible from those before it
+//   LANDMARKS_AVOID     Goldberg & Werneck's "avoid": grow a tree from a
+//                       random root and walk down into the subtree whose
+//                       vertices the current landmarks bound worst.
+//
+// Distances are stored per vertex, landmarks side by side, so a bound
+// reads two short contiguous rows. Memory is 2 * n * count ints; more
+// landmarks give tighter bounds and fewer expanded vertices.
+//
+enum LandmarkSelection { LANDMARKS_FARTHEST, LANDMARKS_AVOID };
+
+struct Landmarks {
+    int n;
+    int count;
+    int stride;         // row width; count can fall short on tiny graphs
+    int* vertex;        // landmark ids
+    int* priceDist;     // priceDist[v * stride + i] = dist(landmark i, v)
+    int* timeDist;
+
+    Landmarks(const FlatGraph& graph, ThreadPool& pool, int landmarks,
+              LandmarkSelection selection = LANDMARKS_AVOID, uint64_t seed = 1)
+        : n(graph.n), count(0)
+    {
+        if (landmarks > n) landmarks = n;
+        if (landmarks < 1) landmarks = 1;
+
+        stride = landmarks;
+        vertex = new int[stride];
+        priceDist = new int[(long)n * stride];
+        timeDist = new int[(long)n * stride];
+
+        DeltaStepping sssp(graph, pool);
+        Random rng(seed);
+
+        // For farthest selection: distance to the nearest landmark so
+        // far (to a random vertex before the first one), -1 if unreached.
+        int* nearest = nullptr;
+        if (selection == LANDMARKS_FARTHEST) {
+            nearest = new int[n];
+            ShortestPathTree* start = sssp.run(rng.between(0, n - 1), USE_PRICE);
+            for (int v = 0; v < n; v++)
+                nearest[v] = start->reached(v) ? start->dist[v] : -1;
+            delete start;
+        }
+
+        while (count < landmarks) {
+            int next = nearest ? farthest(nearest) : avoid(sssp, rng);
+            if (next < 0) break;
+
+            vertex[count] = next;
+            ShortestPathTree* byPrice = sssp.run(next, USE_PRICE);
+            ShortestPathTree* byTime = sssp.run(next, USE_TIME);
+            for (int v = 0; v < n; v++) {
+                priceDist[(long)v * stride + count] = byPrice->dist[v];
+                timeDist[(long)v * stride + count] = byTime->dist[v];
+
+                if (nearest && nearest[v] >= 0 &&
+                    (count == 0 || byPrice->dist[v] < nearest[v]))
+                    nearest[v] = byPrice->dist[v];
+            }
+            delete byPrice;
+            delete byTime;
+            count++;
+        }
+        delete[] nearest;
+    }
+
+    Landmarks(const Landmarks&) = delete;
+    Landmarks& operator=(const Landmarks&) = delete;
+
+    ~Landmarks() {
+        delete[] vertex;
+        delete[] priceDist;
+        delete[] timeDist;
+    }
+
+    // Lower bound on the cost from v to t.
+    int bound(int v, int t, WeightMode mode) const {
+        const int* d = mode == USE_PRICE ? priceDist : timeDist;
+        const int* dv = d + (long)v * stride;
+        const int* dt = d + (long)t * stride;
+
+        int best = 0;
+        for (int i = 0; i < count; i++) {
+            if (dv[i] == INT_MAX || dt[i] == INT_MAX) continue;
+            int diff = dt[i] > dv[i] ? dt[i] - dv[i] : dv[i] - dt[i];
+            if (diff > best) best = diff;
+        }
+        return best;
+    }
+
+    // True if some landmark reaches exactly one of v and t, which puts
+    // them in different components: no route, whatever the bound says.
+    bool separated(int v, int t) const {
+        const int* dv = priceDist + (long)v * stride;
+        const int* dt = priceDist + (long)t * stride;
+        for (int i = 0; i < count; i++)
+            if ((dv[i] == INT_MAX) != (dt[i] == INT_MAX)) return true;
+        return false;
+    }
+
+    long bytes() const {
+        return (long)stride * sizeof(int) + 2L * n * stride * sizeof(int);
+    }
+
+private:
+    int farthest(const int* nearest) const {
+        int best = -1;
+        for (int v = 0; v < n; v++)
+            if (nearest[v] > 0 && (best < 0 || nearest[v] > nearest[best]))
+                best = v;
+        return best;
+    }
+
+    bool isLandmark(int v) const {
+        for (int i = 0; i < count; i++)
+            if (vertex[i] == v) return true;
+        return false;
+    }
+
+    int avoid(DeltaStepping& sssp, Random& rng) {
+        for (int attempt = 0; attempt < 8; attempt++) {
+            int pick = avoidFrom(sssp, rng.between(0, n - 1));
+            if (pick >= 0) return pick;
+        }
+        return -1;
+    }
+
+    // One round of "avoid" from `root`: every vertex in the shortest-path
+    // tree weighs dist(root, v) minus its current lower bound, a subtree
+    // that already holds a landmark is skipped, and the walk from the root
+    // follows the heaviest child down to a leaf.
+    int avoidFrom(DeltaStepping& sssp, int root) {
+        ShortestPathTree* tree = sssp.run(root, USE_PRICE);
+
+        // Children lists (CSR by parent) and a top-down order.
+        int* first = new int[n + 1];
+        int* child = new int[n];
+        int* order = new int[n];
+        for (int v = 0; v <= n; v++) first[v] = 0;
+        for (int v = 0; v < n; v++)
+            if (tree->pred[v] >= 0) first[tree->pred[v] + 1]++;
+        for (int v = 0; v < n; v++) first[v + 1] += first[v];
+
+        int* fill = new int[n];
+        for (int v = 0; v < n; v++) fill[v] = first[v];
+        for (int v = 0; v < n; v++)
+            if (tree->pred[v] >= 0) child[fill[tree->pred[v]]++] = v;
+        delete[] fill;
+
+        int size = 0;
+        order[size++] = root;
+        for (int i = 0; i < size; i++)
+            for (int k = first[order[i]]; k < first[order[i] + 1]; k++)
+                order[size++] = child[k];
+
+        long* weight = new long[n];
+        for (int i = size - 1; i >= 0; i--) {
+            int v = order[i];
+            int lower = 0;
+            for (int l = 0; l < count; l++) {
+                int a = priceDist[(long)root * stride + l];
+                int b = priceDist[(long)v * stride + l];
+                if (a == INT_MAX || b == INT_MAX) continue;
+                int diff = a > b ? a - b : b - a;
+                if (diff > lower) lower = diff;
+            }
+
+            weight[v] = tree->dist[v] - lower;
+            for (int k = first[v]; k < first[v + 1]; k++) {
+                int c = child[k];
+                if (weight[c] < 0) { weight[v] = -1; break; }
+                weight[v] += weight[c];
+            }
+            if (isLandmark(v)) weight[v] = -1;    // -1: holds a landmark
+        }
+
+        // The root's own subtree holds every landmark in reach, so start
+        // the walk from its children.
+        int v = root;
+        while (true) {
+            int next = -1;
+            for (int k = first[v]; k < first[v + 1]; k++)
+                if (weight[child[k]] > 0 &&
+                    (next < 0 || weight[child[k]] > weight[next]))
+                    next = child[k];
+            if (next < 0) break;
+            v = next;
+        }
+        int pick = v != root ? v : -1;
+
+        delete tree;
+        delete[] first;
+        delete[] child;
+        delete[] order;
+        delete[] weight;
+        return pick;
+    }
+};
+
+//
+// ─── ALT SEARCH ────────────────────────────────────────────────────────
+//
+// A* over a FlatGraph with Landmarks::bound as the heuristic. Because the
+// bound is consistent every vertex is settled at most once, exactly as in
+// Dijkstra, and the route costs the same; only fewer vertices get there.
+// Scratch arrays are reset lazily with a query stamp. One object per
+// thread.
+//
+class AltSearch {
+    const FlatGraph& graph;
+    const Landmarks& landmarks;
+    MinHeap heap;
+    int* dist;
+    int* predEdge;
+    int* stamp;
+    int current;
+
+    int distance(int v) const { return stamp[v] == current ? dist[v] : INT_MAX; }
+
+public:
+    AltSearch(const FlatGraph& g, const Landmarks& l)
+        : graph(g), landmarks(l), heap(g.n), dist(new int[g.n]),
+          predEdge(new int[g.n]), stamp(new int[g.n]), current(0)
+    {
+        for (int v = 0; v < g.n; v++)
+            stamp[v] = 0;
+    }
+
+    AltSearch(const AltSearch&) = delete;
+    AltSearch& operator=(const AltSearch&) = delete;
+
+    ~AltSearch() {
+        delete[] dist;
+        delete[] predEdge;
+        delete[] stamp;
+    }
+
+    Route route(int source, int dest, WeightMode mode) {
+        auto started = std::chrono::steady_clock::now();
+        const int* w = graph.weights(mode);
+        Route result;
+        SearchStats& stats = result.stats;
+
+        current++;
+        heap.clear();
+
+        dist[source] = 0;
+        predEdge[source] = -1;
+        stamp[source] = current;
+        heap.push(source, landmarks.bound(source, dest, mode));
+
+        bool reached = false;
+        while (!heap.isEmpty()) {
+            if (heap.size() > stats.peakFrontier)
+                stats.peakFrontier = heap.size();
+
+            int u = heap.pop();
+            if (u == dest) {
+                reached = true;
+                break;
+            }
+            stats.nodesExpanded++;
+
+            int du = dist[u];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                int dv = du + w[e];
+                stats.edgesRelaxed++;
+                if (dv < distance(v)) {
+                    dist[v] = dv;
+                    predEdge[v] = e;
+                    stamp[v] = current;
+                    heap.push(v, dv + landmarks.bound(v, dest, mode));
+                }
+            }
+        }
+        stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (reached) {
+            ArrayList<int> reversed;
+            for (int v = dest; v != source; v = graph.edgeSource(predEdge[v]))
+                reversed.append(predEdge[v]);
+
+            ArrayList<int> edges;
+            result.vertices.append(source);
+            for (int i = reversed.size() - 1; i >= 0; i--) {
+                edges.append(reversed[i]);
+                result.vertices.append(graph.targets[reversed[i]]);
+            }
+            graph.setLegs(result, edges);
+        }
+        stats.extractMs = millisSince(extracting);
+
+        return result;
+    }
+};
+
+#endif
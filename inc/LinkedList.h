@@ -1,12 +1,16 @@
 #ifndef LINKED_LIST_H
 #define LINKED_LIST_H
 
+#include <NodePool.h>
 #include <iostream>
+#include <stdexcept>
 
-template <class T> class LinkedList;
+template <class T> struct Link;
 
-template <class T>
-std::ostream &operator<<(std::ostream &os, const LinkedList<T> &list);
+template <class T, class Alloc = NodePool<Link<T>>> class LinkedList;
+
+template <class T, class Alloc>
+std::ostream &operator<<(std::ostream &os, const LinkedList<T, Alloc> &list);
 
 template <class T> struct Link {
     T data;
@@ -26,11 +30,17 @@ template <class T> struct Link {
     }
 };
 
-template <class T> class LinkedList {
+//
+// Links come from `Alloc` (see NodePool.h): by default a per-list slab
+// pool that recycles removed links, so a list that grows and shrinks
+// around the same size stops allocating once it has reached it.
+//
+template <class T, class Alloc> class LinkedList {
 protected:
     Link<T> *front;
     Link<T> *back;
     int count;
+    Alloc nodes;
 
 public:
     LinkedList() {
@@ -85,7 +95,7 @@ public:
     }
 
     void append(T value) {
-        Link<T> *newLink = new Link<T>(value);
+        Link<T> *newLink = nodes.create(value);
 
         if (front == nullptr) {
             front = newLink;
@@ -99,7 +109,7 @@ public:
     }
 
     void prepend(T value) {
-        Link<T> *newLink = new Link<T>(value);
+        Link<T> *newLink = nodes.create(value);
 
         if (front == nullptr) {
             front = newLink;
@@ -118,7 +128,7 @@ public:
         } else if (front == back) {
             T target = front->data;
 
-            delete front;
+            nodes.destroy(front);
             front = nullptr;
             back = nullptr;
             count--;
@@ -130,7 +140,7 @@ public:
             Link<T> *oldFront = front;
             front = front->next;
             front->prev = nullptr;
-            delete oldFront;
+            nodes.destroy(oldFront);
             count--;
 
             return target;
@@ -143,7 +153,7 @@ public:
         } else if (front == back) {
             T target = front->data;
 
-            delete front;
+            nodes.destroy(front);
             front = nullptr;
             back = nullptr;
             count--;
@@ -155,7 +165,7 @@ public:
             Link<T> *oldBack = back;
             back = back->prev;
             back->next = nullptr;
-            delete oldBack;
+            nodes.destroy(oldBack);
             count--;
 
             return target;
@@ -164,6 +174,8 @@ public:
 
     int size() const { return count; }
 
+    const AllocationStats &allocationStats() const { return nodes.stats(); }
+
     ~LinkedList() {
         while (front != nullptr) {
             removeFirst();
@@ -171,13 +183,13 @@ public:
     }
 
     friend std::ostream &operator<< <>(std::ostream &os,
-                                       const LinkedList<T> &list);
+                                       const LinkedList<T, Alloc> &list);
     friend struct TestLinkedList;
     friend struct Graph;
 };
 
-template <class T>
-std::ostream &operator<<(std::ostream &os, const LinkedList<T> &list) {
+template <class T, class Alloc>
+std::ostream &operator<<(std::ostream &os, const LinkedList<T, Alloc> &list) {
     Link<T> *temp = list.front;
 
     while (temp != nullptr) {
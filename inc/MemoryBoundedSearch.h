@@ -0,0 +1,543 @@
+#ifndef MEMORY_BOUNDED_SEARCH_H
+#define MEMORY_BOUNDED_SEARCH_H
+
+#include <FlatGraph.h>
+#include <Landmarks.h>
+#include <MinHeap.h>
+#include <Stack.h>
+#include <climits>
+
+//
+// ─── MEMORY-BOUNDED SEARCH ─────────────────────────────────────────────
+//
+// Graph::ucs keeps every Waypoint it ever created until the query ends,
+// one per relaxed edge. The two searches below keep a fixed amount of
+// per-query state instead, so many of them can run side by side on a
+// small host. Both are optimal for the same reason A* is: the heuristic
+// (Landmarks::bound, or 0 without landmarks) never overestimates.
+//
+// Both are tree searches over simple paths: a vertex is never repeated
+// on the current path, but may be reached again along another one. That
+// is what keeps them small, and what they pay for in time. A destination
+// that cannot be reached at all would have them try every simple path,
+// so each query first checks that source and destination are connected:
+// with Landmarks::separated, or else with component ids computed once
+// per object (one int per vertex).
+//
+
+// Connected component of every vertex (every flight goes both ways).
+// The caller owns the array.
+inline int* componentIds(const FlatGraph& g) {
+    int* component = new int[g.n > 0 ? g.n : 1];
+    int* queue = new int[g.n > 0 ? g.n : 1];
+    for (int v = 0; v < g.n; v++)
+        component[v] = -1;
+
+    int count = 0;
+    for (int root = 0; root < g.n; root++) {
+        if (component[root] >= 0) continue;
+
+        int head = 0, tail = 0;
+        component[root] = count;
+        queue[tail++] = root;
+        while (head < tail) {
+            int u = queue[head++];
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                if (component[v] < 0) {
+                    component[v] = count;
+                    queue[tail++] = v;
+                }
+            }
+        }
+        count++;
+    }
+
+    delete[] queue;
+    return component;
+}
+
+//
+// ─── IDA* ──────────────────────────────────────────────────────────────
+//
+// Iterative-deepening A* (Korf): depth-first passes that cut every path
+// whose cost plus heuristic exceeds a bound, raising the bound to the
+// smallest cut value after each pass. The only per-query state is the
+// current path, kept as a Stack of frames (vertex, next edge to try, cost
+// so far); its pooled links make the pushes and pops allocation-free
+// after the first pass. Peak memory is O(route length).
+//
+// onPath is one byte per vertex, cleared as frames are popped. One
+// object per thread.
+//
+class IDAStar {
+    struct Frame {
+        int vertex;
+        int edge;       // next edge of vertex to try
+        int cost;
+        int via;        // edge that led here, -1 at the source
+    };
+
+    const FlatGraph& graph;
+    const Landmarks* landmarks;
+    int* component;     // only without landmarks
+    bool* onPath;
+
+    int heuristic(int v, int t, WeightMode mode) const {
+        return landmarks ? landmarks->bound(v, t, mode) : 0;
+    }
+
+    bool separated(int s, int t) const {
+        return landmarks ? landmarks->separated(s, t) : component[s] != component[t];
+    }
+
+public:
+    explicit IDAStar(const FlatGraph& g, const Landmarks* l = nullptr)
+        : graph(g), landmarks(l), component(l ? nullptr : componentIds(g)),
+          onPath(new bool[g.n])
+    {
+        for (int v = 0; v < g.n; v++)
+            onPath[v] = false;
+    }
+
+    IDAStar(const IDAStar&) = delete;
+    IDAStar& operator=(const IDAStar&) = delete;
+
+    ~IDAStar() {
+        delete[] component;
+        delete[] onPath;
+    }
+
+    // peakFrontier is the deepest the path got; waypointsAllocated counts
+    // frames pushed over all passes.
+    Route route(int source, int dest, WeightMode mode,
+                SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
+        const int* w = graph.weights(mode);
+        Route result;
+        SearchStats& stats = result.stats;
+
+        if (separated(source, dest)) {
+            stats.searchMs = millisSince(started);
+            return result;
+        }
+
+        Stack<Frame> path;
+        ArrayList<int> edges;
+        int bound = heuristic(source, dest, mode);
+        bool reached = false, cancelled = false;
+        stats.peakFrontier = 1;
+
+        while (!reached && !cancelled && bound != INT_MAX) {
+            int next = INT_MAX;     // smallest f cut off in this pass
+            long depth = 1;
+
+            path.push({ source, graph.offsets[source], 0, -1 });
+            onPath[source] = true;
+            stats.waypointsAllocated++;
+
+            while (!path.isEmpty()) {
+                if (control && control->check(stats.nodesExpanded)) {
+                    cancelled = true;
+                    break;
+                }
+
+                Frame top = path.pop();
+                if (top.vertex == dest) {
+                    // The stack holds the route, destination first.
+                    ArrayList<int> reversed;
+                    if (top.via >= 0) reversed.append(top.via);
+                    while (!path.isEmpty()) {
+                        Frame f = path.pop();
+                        onPath[f.vertex] = false;
+                        if (f.via >= 0) reversed.append(f.via);
+                    }
+                    for (int i = reversed.size() - 1; i >= 0; i--)
+                        edges.append(reversed[i]);
+                    onPath[top.vertex] = false;
+                    reached = true;
+                    break;
+                }
+
+                if (top.edge == graph.offsets[top.vertex + 1]) {
+                    onPath[top.vertex] = false;
+                    depth--;
+                    continue;
+                }
+                if (top.edge == graph.offsets[top.vertex])
+                    stats.nodesExpanded++;
+
+                int e = top.edge++;
+                path.push(top);
+
+                int v = graph.targets[e];
+                stats.edgesRelaxed++;
+                if (onPath[v]) continue;
+
+                int cost = top.cost + w[e];
+                int f = cost + heuristic(v, dest, mode);
+                if (f > bound) {
+                    if (f < next) next = f;
+                    continue;
+                }
+
+                path.push({ v, graph.offsets[v], cost, e });
+                onPath[v] = true;
+                stats.waypointsAllocated++;
+                if (++depth > stats.peakFrontier) stats.peakFrontier = depth;
+            }
+
+            while (!path.isEmpty())
+                onPath[path.pop().vertex] = false;
+            bound = next;
+        }
+        stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (reached) {
+            result.vertices.append(source);
+            for (int i = 0; i < edges.size(); i++)
+                result.vertices.append(graph.targets[edges[i]]);
+            graph.setLegs(result, edges);
+        }
+        stats.extractMs = millisSince(extracting);
+        return result;
+    }
+};
+
+//
+// ─── SMA* ──────────────────────────────────────────────────────────────
+//
+// Simplified memory-bounded A* (Russell) with room for `budget` search
+// nodes, allocated once. It runs like A*, generating one successor at a
+// time, until the nodes run out; then the leaf with the worst f is
+// dropped and its f is remembered by its parent ("forgotten"), so the
+// parent is revisited and the subtree regrown only if it becomes the best
+// option again. f values are backed up: a node's f rises to the smallest
+// f among its children, dropped or not, and the successors still to come.
+//
+// The route is optimal as long as it has fewer than `budget` vertices;
+// longer routes are out of reach. With a budget close to the route length
+// most of the time goes into regrowing the same subtrees, so leave a few
+// times the expected number of legs. Both queues are indexed heaps over
+// node slots: `open` by f for nodes with successors left to generate,
+// `leaves` by -f to find the node to drop. One object per thread.
+//
+class SMAStar {
+    const FlatGraph& graph;
+    const Landmarks* landmarks;
+    int* component;     // only without landmarks
+    int budget;
+
+    // Node slots
+    int* vertex;
+    int* parent;
+    int* via;           // edge from the parent, -1 at the root
+    int* cost;
+    int* f;
+    int* cursor;        // next edge of vertex to generate
+    int* forgotten;     // smallest f among dropped children, INT_MAX if none
+    int* regrow;        // f floor for children regrown from `forgotten`
+    int* live;          // children in memory
+    int* child;         // first child in memory
+    int* sibling;       // next sibling, or next free slot
+    int* previous;      // previous sibling, -1 for the first child
+    int freeSlot;
+    int used;
+
+    MinHeap open;
+    MinHeap leaves;
+
+    int heuristic(int v, int t, WeightMode mode) const {
+        return landmarks ? landmarks->bound(v, t, mode) : 0;
+    }
+
+    bool separated(int s, int t) const {
+        return landmarks ? landmarks->separated(s, t) : component[s] != component[t];
+    }
+
+    bool generated(int x) const { return cursor[x] == graph.offsets[vertex[x] + 1]; }
+
+    bool hasMore(int x) const { return !generated(x) || forgotten[x] != INT_MAX; }
+
+    // Key in `open`: once every successor has been generated, only the
+    // dropped ones are left, and they cost at least `forgotten`; while
+    // they are being regrown, at least what they were dropped at.
+    int openKey(int x) const {
+        if (generated(x)) return forgotten[x];
+        return f[x] > regrow[x] ? f[x] : regrow[x];
+    }
+
+    bool onPath(int x, int v) const {
+        for (; x >= 0; x = parent[x])
+            if (vertex[x] == v) return true;
+        return false;
+    }
+
+    bool hasChild(int x, int e) const {
+        for (int c = child[x]; c >= 0; c = sibling[c])
+            if (via[c] == e) return true;
+        return false;
+    }
+
+    // Next edge of x worth a node: not back onto the path, not to a child
+    // already in memory. Starts over once if children were dropped.
+    int nextEdge(int x) {
+        while (true) {
+            int end = graph.offsets[vertex[x] + 1];
+            while (cursor[x] < end) {
+                int e = cursor[x]++;
+                if (!onPath(x, graph.targets[e]) && !hasChild(x, e)) return e;
+            }
+            if (forgotten[x] == INT_MAX) return -1;
+            cursor[x] = graph.offsets[vertex[x]];
+            regrow[x] = forgotten[x];
+            forgotten[x] = INT_MAX;
+        }
+    }
+
+    int allocate() {
+        int x = freeSlot;
+        freeSlot = sibling[x];
+        used++;
+        return x;
+    }
+
+    // Unlinks x from its parent and returns its slot.
+    void release(int x) {
+        int p = parent[x];
+        if (p >= 0) {
+            if (previous[x] >= 0) sibling[previous[x]] = sibling[x];
+            else child[p] = sibling[x];
+            if (sibling[x] >= 0) previous[sibling[x]] = previous[x];
+            live[p]--;
+        }
+        open.remove(x);
+        leaves.remove(x);
+
+        sibling[x] = freeSlot;
+        freeSlot = x;
+        used--;
+    }
+
+    // Puts x back in the queues it belongs in, with current keys.
+    void requeue(int x) {
+        open.remove(x);
+        if (hasMore(x)) open.push(x, openKey(x));
+        leaves.remove(x);
+        if (live[x] == 0) leaves.push(x, -f[x]);
+    }
+
+    // Backs f up from x towards the root after x changed: the smallest of
+    // its children in memory, its dropped children and, until all its
+    // successors are out, the successors still to come. f only rises, so
+    // the walk stops at the first ancestor it leaves alone. Dead ends
+    // (nothing in memory, nothing left to generate) are dropped.
+    void update(int x) {
+        while (x >= 0) {
+            int best = forgotten[x];
+            for (int c = child[x]; c >= 0; c = sibling[c])
+                if (f[c] < best) best = f[c];
+            if (!generated(x)) {
+                int pending = f[x] > regrow[x] ? f[x] : regrow[x];
+                if (pending < best) best = pending;
+            }
+
+            int p = parent[x];
+            if (best == INT_MAX && p >= 0) {
+                release(x);
+                x = p;
+                continue;
+            }
+
+            bool raised = best > f[x];
+            if (raised) f[x] = best;
+            requeue(x);
+            if (!raised) return;
+            x = p;
+        }
+    }
+
+    // Drops the worst leaf other than `keep`, leaving its f with its
+    // parent. False if there is none.
+    bool makeRoom(int keep) {
+        leaves.remove(keep);
+        bool found = !leaves.isEmpty();
+        if (found) {
+            int victim = leaves.pop();
+            int p = parent[victim];
+            if (f[victim] < forgotten[p]) forgotten[p] = f[victim];
+            // Mid-regrowth the cursor may come round to it again.
+            if (!generated(p) && f[victim] < regrow[p]) regrow[p] = f[victim];
+            release(victim);
+            update(p);
+        }
+        if (live[keep] == 0) leaves.push(keep, -f[keep]);
+        return found;
+    }
+
+public:
+    SMAStar(const FlatGraph& g, int nodeBudget, const Landmarks* l = nullptr)
+        : graph(g), landmarks(l), component(l ? nullptr : componentIds(g)),
+          budget(nodeBudget < 2 ? 2 : nodeBudget),
+          open(budget), leaves(budget)
+    {
+        vertex = new int[budget];
+        parent = new int[budget];
+        via = new int[budget];
+        cost = new int[budget];
+        f = new int[budget];
+        cursor = new int[budget];
+        forgotten = new int[budget];
+        regrow = new int[budget];
+        live = new int[budget];
+        child = new int[budget];
+        sibling = new int[budget];
+        previous = new int[budget];
+    }
+
+    SMAStar(const SMAStar&) = delete;
+    SMAStar& operator=(const SMAStar&) = delete;
+
+    ~SMAStar() {
+        delete[] component;
+        delete[] vertex;
+        delete[] parent;
+        delete[] via;
+        delete[] cost;
+        delete[] f;
+        delete[] cursor;
+        delete[] forgotten;
+        delete[] regrow;
+        delete[] live;
+        delete[] child;
+        delete[] sibling;
+        delete[] previous;
+    }
+
+    int nodeBudget() const { return budget; }
+
+    // Twelve ints per slot plus two heaps of three, and the component ids.
+    long bytes() const {
+        return (18L * budget + (component ? graph.n : 0)) * sizeof(int);
+    }
+
+    // nodesExpanded counts successor steps; peakFrontier is the most
+    // nodes held at once (never above the budget); waypointsAllocated
+    // counts nodes generated, regrown ones included.
+    Route route(int source, int dest, WeightMode mode,
+                SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
+        const int* w = graph.weights(mode);
+        Route result;
+        SearchStats& stats = result.stats;
+
+        open.clear();
+        leaves.clear();
+        for (int x = 0; x < budget; x++)
+            sibling[x] = x + 1 < budget ? x + 1 : -1;
+        freeSlot = 0;
+        used = 0;
+
+        if (separated(source, dest)) {
+            stats.searchMs = millisSince(started);
+            return result;
+        }
+
+        int root = allocate();
+        vertex[root] = source;
+        parent[root] = -1;
+        via[root] = -1;
+        cost[root] = 0;
+        f[root] = heuristic(source, dest, mode);
+        cursor[root] = graph.offsets[source];
+        forgotten[root] = INT_MAX;
+        regrow[root] = 0;
+        live[root] = 0;
+        child[root] = -1;
+        open.push(root, f[root]);
+        leaves.push(root, -f[root]);
+        stats.waypointsAllocated = 1;
+        stats.peakFrontier = 1;
+
+        int goal = -1;
+        while (!open.isEmpty() && open.minKey() != INT_MAX) {
+            if (control && control->check(stats.nodesExpanded))
+                break;
+
+            int b = open.peek();
+            if (vertex[b] == dest) {
+                goal = b;
+                break;
+            }
+
+            // Make room first: dropping a leaf can change b, and the
+            // successor must not be half-generated while it does.
+            if (freeSlot < 0) {
+                if (!makeRoom(b)) {
+                    // Every node is on b's path: nothing more would fit.
+                    cursor[b] = graph.offsets[vertex[b] + 1];
+                    forgotten[b] = INT_MAX;
+                    update(b);
+                }
+                continue;
+            }
+
+            int e = nextEdge(b);
+            if (e < 0) {
+                update(b);
+                continue;
+            }
+            stats.nodesExpanded++;
+            stats.edgesRelaxed++;
+
+            int v = graph.targets[e];
+            int fs = cost[b] + w[e] + heuristic(v, dest, mode);
+            if (fs < f[b]) fs = f[b];   // pathmax
+            if (fs < regrow[b]) fs = regrow[b];
+
+            int s = allocate();
+            vertex[s] = v;
+            parent[s] = b;
+            via[s] = e;
+            cost[s] = cost[b] + w[e];
+            f[s] = fs;
+            cursor[s] = graph.offsets[v];
+            forgotten[s] = INT_MAX;
+            regrow[s] = 0;
+            live[s] = 0;
+            child[s] = -1;
+
+            previous[s] = -1;
+            sibling[s] = child[b];
+            if (child[b] >= 0) previous[child[b]] = s;
+            child[b] = s;
+            live[b]++;
+
+            requeue(s);
+            update(b);
+            stats.waypointsAllocated++;
+            if (used > stats.peakFrontier) stats.peakFrontier = used;
+        }
+        stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (goal >= 0) {
+            ArrayList<int> reversed;
+            for (int x = goal; parent[x] >= 0; x = parent[x])
+                reversed.append(via[x]);
+
+            ArrayList<int> edges;
+            result.vertices.append(source);
+            for (int i = reversed.size() - 1; i >= 0; i--) {
+                edges.append(reversed[i]);
+                result.vertices.append(graph.targets[reversed[i]]);
+            }
+            graph.setLegs(result, edges);
+        }
+        stats.extractMs = millisSince(extracting);
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef MIN_HEAP_H
+#define MIN_HEAP_H
+
+//
+// ─── INDEXED MIN-HEAP ──────────────────────────────────────────────────
+//
+// Binary heap of vertex ids 0 .. n-1 ordered by an int key, with
+// decrease-key. Each vertex is in the heap at most once, so a search
+// needs O(n) heap space no matter how many edges it relaxes (unlike the
+// sorted frontier in Graph::ucs, which holds one entry per relaxation).
+//
+class MinHeap {
+    int* items;     // heap-ordered vertex ids
+    int* keys;      // key of items[i]
+    int* position;  // index of v in items, or -1
+    int count;
+    int capacity;
+
+    void swap(int i, int j) {
+        int v = items[i], k = keys[i];
+        items[i] = items[j];
+        keys[i] = keys[j];
+        items[j] = v;
+        keys[j] = k;
+        position[items[i]] = i;
+        position[items[j]] = j;
+    }
+
+    void up(int i) {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (keys[parent] <= keys[i]) break;
+            swap(i, parent);
+            i = parent;
+        }
+    }
+
+    void down(int i) {
+        while (true) {
+            int l = 2 * i + 1, r = l + 1, smallest = i;
+            if (l < count && keys[l] < keys[smallest]) smallest = l;
+            if (r < count && keys[r] < keys[smallest]) smallest = r;
+            if (smallest == i) return;
+            swap(i, smallest);
+            i = smallest;
+        }
+    }
+
+public:
+    explicit MinHeap(int n)
+        : items(new int[n]), keys(new int[n]), position(new int[n]),
+          count(0), capacity(n)
+    {
+        for (int v = 0; v < n; v++)
+            position[v] = -1;
+    }
+
+    MinHeap(const MinHeap&) = delete;
+    MinHeap& operator=(const MinHeap&) = delete;
+
+    ~MinHeap() {
+        delete[] items;
+        delete[] keys;
+        delete[] position;
+    }
+
+    bool isEmpty() const { return count == 0; }
+
+    int size() const { return count; }
+
+    bool contains(int v) const { return position[v] >= 0; }
+
+    int minKey() const { return keys[0]; }
+
+    int peek() const { return items[0]; }
+
+    // Inserts v, or lowers its key if it is already queued with a higher one.
+    void push(int v, int key) {
+        int i = position[v];
+        if (i < 0) {
+            i = count++;
+            items[i] = v;
+            keys[i] = key;
+            position[v] = i;
+        } else if (key < keys[i]) {
+            keys[i] = key;
+        } else {
+            return;
+        }
+        up(i);
+    }
+
+    int pop() {
+        int v = items[0];
+        swap(0, --count);
+        position[v] = -1;
+        if (count > 0) down(0);
+        return v;
+    }
+
+    // Takes v out of the heap, wherever it is. No-op if it is not queued.
+    void remove(int v) {
+        int i = position[v];
+        if (i < 0) return;
+        swap(i, --count);
+        position[v] = -1;
+        if (i < count) {
+            up(i);
+            down(i);
+        }
+    }
+
+    // Empties the heap in O(size) so it can be reused by the next search.
+    void clear() {
+        for (int i = 0; i < count; i++)
+            position[items[i]] = -1;
+        count = 0;
+    }
+
+    int getCapacity() const { return capacity; }
+};
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef MULTI_SOURCE_BFS_H
+#define MULTI_SOURCE_BFS_H
+
+#include <FlatGraph.h>
+#include <ThreadPool.h>
+#include <climits>
+#include <cstdint>
+
+//
+// ─── HOP MATRIX ────────────────────────────────────────────────────────
+//
+// Fewest flights from sources[i] to targets[j] at hops[i * cols + j];
+// INT_MAX if targets[j] cannot be reached.
+//
+struct HopMatrix {
+    int rows;
+    int cols;
+    int* hops;
+
+    HopMatrix(int r, int c) : rows(r), cols(c), hops(new int[(long)r * c > 0 ? (long)r * c : 1]) {
+        for (long i = 0; i < (long)r * c; i++)
+            hops[i] = INT_MAX;
+    }
+
+    HopMatrix(const HopMatrix&) = delete;
+    HopMatrix& operator=(const HopMatrix&) = delete;
+
+    ~HopMatrix() {
+        delete[] hops;
+    }
+
+    int at(int i, int j) const { return hops[(long)i * cols + j]; }
+};
+
+//
+// ─── LANE MASK ─────────────────────────────────────────────────────────
+//
+// One bit per source of a batch. The word loops have a fixed trip count
+// so the compiler turns them into vector instructions (two SSE or one
+// AVX2 operation per mask).
+//
+struct LaneMask {
+    static const int WORDS = 4;
+    uint64_t w[WORDS];
+
+    void clear() {
+        for (int k = 0; k < WORDS; k++) w[k] = 0;
+    }
+
+    bool any() const {
+        uint64_t x = 0;
+        for (int k = 0; k < WORDS; k++) x |= w[k];
+        return x != 0;
+    }
+
+    // this |= from & ~except; true if any bit was new to `except`.
+    bool addNew(const LaneMask& from, const LaneMask& except) {
+        uint64_t x = 0;
+        for (int k = 0; k < WORDS; k++) {
+            uint64_t d = from.w[k] & ~except.w[k];
+            w[k] |= d;
+            x |= d;
+        }
+        return x != 0;
+    }
+};
+
+//
+// ─── MULTI-SOURCE BFS ──────────────────────────────────────────────────
+//
+// Hop counts from up to LANES sources in one sweep of the graph (Then et
+// al., "The More the Merrier"). Every vertex carries three lane masks:
+// which sources have reached it, which reached it on the last level, and
+// which reach it on this one. Expanding a vertex ORs its frontier mask
+// into each neighbour, so one edge scan advances every source that is
+// standing on that vertex, instead of one BFS per source each paying for
+// its own queue and visited set.
+//
+// Level by level it only touches vertices some source reached last
+// time. When targets are given, the sweep stops as soon as every source
+// has reached all of them. One object per thread; hopMatrix() splits the
+// sources into batches across a pool.
+//
+class MultiSourceBFS {
+    const FlatGraph& graph;
+    LaneMask* seen;
+    LaneMask* visit;
+    LaneMask* next;
+    int* frontier;
+    int* touched;
+    int* column;        // target -> column of the matrix, or -1
+
+public:
+    static const int LANES = 64 * LaneMask::WORDS;
+
+    explicit MultiSourceBFS(const FlatGraph& g)
+        : graph(g), seen(new LaneMask[g.n]), visit(new LaneMask[g.n]),
+          next(new LaneMask[g.n]), frontier(new int[g.n]), touched(new int[g.n]),
+          column(new int[g.n])
+    {
+        for (int v = 0; v < g.n; v++) {
+            seen[v].clear();
+            visit[v].clear();
+            next[v].clear();
+            column[v] = -1;
+        }
+    }
+
+    MultiSourceBFS(const MultiSourceBFS&) = delete;
+    MultiSourceBFS& operator=(const MultiSourceBFS&) = delete;
+
+    ~MultiSourceBFS() {
+        delete[] seen;
+        delete[] visit;
+        delete[] next;
+        delete[] frontier;
+        delete[] touched;
+        delete[] column;
+    }
+
+    // Fills rows first .. first + count - 1 of `out` (count <= LANES) with
+    // hops from sources[0 .. count - 1] to out's targets. Returns the
+    // number of levels swept.
+    int batch(const int* sources, int count, const int* targets, HopMatrix& out, int first) {
+        int n = graph.n;
+        int cols = out.cols;
+        for (int j = 0; j < cols; j++)
+            column[targets[j]] = j;
+        long remaining = (long)count * cols;
+
+        int frontierSize = 0;
+        for (int i = 0; i < count; i++) {
+            int s = sources[i];
+            if (!seen[s].any()) frontier[frontierSize++] = s;
+            seen[s].w[i >> 6] |= (uint64_t)1 << (i & 63);
+            visit[s].w[i >> 6] |= (uint64_t)1 << (i & 63);
+        }
+        for (int k = 0; k < frontierSize; k++)
+            remaining -= record(frontier[k], visit[frontier[k]], 0, out, first);
+
+        int level = 0;
+        while (frontierSize > 0 && remaining > 0) {
+            level++;
+
+            int touchedSize = 0;
+            for (int k = 0; k < frontierSize; k++) {
+                int u = frontier[k];
+                for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                    int v = graph.targets[e];
+                    bool fresh = !next[v].any();
+                    if (next[v].addNew(visit[u], seen[v]) && fresh)
+                        touched[touchedSize++] = v;
+                }
+            }
+
+            for (int k = 0; k < frontierSize; k++)
+                visit[frontier[k]].clear();
+
+            // Every touched vertex got at least one new source.
+            for (int k = 0; k < touchedSize; k++) {
+                int v = touched[k];
+                for (int w = 0; w < LaneMask::WORDS; w++) {
+                    seen[v].w[w] |= next[v].w[w];
+                    visit[v].w[w] = next[v].w[w];
+                }
+                next[v].clear();
+                remaining -= record(v, visit[v], level, out, first);
+                frontier[k] = v;
+            }
+            frontierSize = touchedSize;
+        }
+
+        for (int k = 0; k < frontierSize; k++)
+            visit[frontier[k]].clear();
+        for (int v = 0; v < n; v++)
+            seen[v].clear();
+        for (int j = 0; j < cols; j++)
+            column[targets[j]] = -1;
+        return level;
+    }
+
+private:
+    // Writes `level` for each lane of `lanes` if v is a target; returns
+    // how many matrix cells that filled.
+    int record(int v, const LaneMask& lanes, int level, HopMatrix& out, int first) {
+        int j = column[v];
+        if (j < 0) return 0;
+
+        int filled = 0;
+        for (int w = 0; w < LaneMask::WORDS; w++) {
+            uint64_t bits = lanes.w[w];
+            while (bits) {
+                int lane = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                out.hops[(long)(first + lane) * out.cols + j] = level;
+                filled++;
+            }
+        }
+        return filled;
+    }
+};
+
+//
+// ─── HOP MATRICES ──────────────────────────────────────────────────────
+//
+// Many-to-many fewest-stops matrix, LANES sources per batch and batches
+// spread over the pool. Sources may repeat; targets must be distinct.
+// Caller owns the result.
+//
+inline HopMatrix* hopMatrix(const FlatGraph& g, const int* sources, int rows,
+                            const int* targets, int cols, ThreadPool& pool) {
+    HopMatrix* out = new HopMatrix(rows, cols);
+    int batches = (rows + MultiSourceBFS::LANES - 1) / MultiSourceBFS::LANES;
+    int workers = pool.size();
+
+    MultiSourceBFS** searches = new MultiSourceBFS*[workers];
+    for (int t = 0; t < workers; t++)
+        searches[t] = nullptr;
+
+    pool.parallelFor(0, batches, [&](int b, int worker) {
+        if (searches[worker] == nullptr)
+            searches[worker] = new MultiSourceBFS(g);
+
+        int first = b * MultiSourceBFS::LANES;
+        int count = rows - first < MultiSourceBFS::LANES ? rows - first : MultiSourceBFS::LANES;
+        searches[worker]->batch(sources + first, count, targets, *out, first);
+    }, 1);
+
+    for (int t = 0; t < workers; t++)
+        delete searches[t];
+    delete[] searches;
+    return out;
+}
+
+// Every airport to every airport: row and column v are vertex v.
+inline HopMatrix* allPairsHops(const FlatGraph& g, ThreadPool& pool) {
+    int* all = new int[g.n > 0 ? g.n : 1];
+    for (int v = 0; v < g.n; v++)
+        all[v] = v;
+
+    HopMatrix* out = hopMatrix(g, all, g.n, all, g.n, pool);
+    delete[] all;
+    return out;
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <new>
+#include <utility>
+
+//
+// ─── ALLOCATION STATS ──────────────────────────────────────────────────
+//
+// What a node allocator has done so far. heapAllocations counts calls
+// into operator new; a push/pop workload that has reached its peak size
+// should leave it unchanged.
+//
+struct AllocationStats {
+    long heapAllocations;   // operator new calls (slabs or single nodes)
+    long heapFrees;
+    long created;           // nodes handed out
+    long recycled;          // ... of which came off the free list
+    long live;              // nodes handed out and not yet released
+
+    AllocationStats()
+        : heapAllocations(0), heapFrees(0), created(0), recycled(0), live(0) {}
+};
+
+//
+// ─── NODE POOL ─────────────────────────────────────────────────────────
+//
+// Slab allocator for fixed-size nodes. Memory is taken from the heap in
+// slabs of doubling size (8, 16, ... up to MAX_SLAB nodes); released
+// nodes go onto an intrusive free list and are handed out again first,
+// so create and destroy are O(1) and stop touching malloc once the pool
+// has grown to the container's peak size. Slabs are only returned when
+// the pool itself is destroyed.
+//
+// Not thread-safe: one pool per container, like the containers.
+//
+template <class Node> class NodePool {
+    union Slot {
+        Slot *nextFree;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    static const int FIRST_SLAB = 8;
+    static const int MAX_SLAB = 1024;
+
+    Slot *slabs;        // slot 0 of every slab links to the previous slab
+    Slot *freeList;
+    Slot *unused;       // untouched slots at the end of the newest slab
+    int remaining;
+    int nextSlab;
+    AllocationStats counts;
+
+    void grow() {
+        Slot *slab = new Slot[nextSlab + 1];
+        counts.heapAllocations++;
+
+        slab[0].nextFree = slabs;
+        slabs = slab;
+        unused = slab + 1;
+        remaining = nextSlab;
+        if (nextSlab < MAX_SLAB) nextSlab *= 2;
+    }
+
+public:
+    NodePool()
+        : slabs(nullptr), freeList(nullptr), unused(nullptr), remaining(0),
+          nextSlab(FIRST_SLAB) {}
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    ~NodePool() {
+        while (slabs != nullptr) {
+            Slot *previous = slabs[0].nextFree;
+            delete[] slabs;
+            counts.heapFrees++;
+            slabs = previous;
+        }
+    }
+
+    template <class... Args> Node *create(Args &&...args) {
+        Slot *slot;
+        if (freeList != nullptr) {
+            slot = freeList;
+            freeList = slot->nextFree;
+            counts.recycled++;
+        } else {
+            if (remaining == 0) grow();
+            slot = unused++;
+            remaining--;
+        }
+
+        counts.created++;
+        counts.live++;
+        return new (slot->storage) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node) {
+        node->~Node();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->nextFree = freeList;
+        freeList = slot;
+        counts.live--;
+    }
+
+    const AllocationStats &stats() const { return counts; }
+};
+
+//
+// ─── HEAP NODES ────────────────────────────────────────────────────────
+//
+// The plain new/delete per node that LinkedList used to do, behind the
+// same interface, for comparison and for callers that hand nodes across
+// lists or threads.
+//
+template <class Node> class HeapNodes {
+    AllocationStats counts;
+
+public:
+    template <class... Args> Node *create(Args &&...args) {
+        counts.heapAllocations++;
+        counts.created++;
+        counts.live++;
+        return new Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node *node) {
+        delete node;
+        counts.heapFrees++;
+        counts.live--;
+    }
+
+    const AllocationStats &stats() const { return counts; }
+};
+
+#endif
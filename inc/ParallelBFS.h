@@ -0,0 +1,278 @@
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include <FlatGraph.h>
+#include <Sort.h>
+#include <ThreadPool.h>
+#include <atomic>
+#include <cstdint>
+
+//
+// ─── DIRECTION-OPTIMIZING BFS ──────────────────────────────────────────
+//
+// Beamer-style BFS for "Fewest Stops". Each level is expanded either
+// top-down (frontier vertices push to their neighbours) or bottom-up
+// (unvisited vertices look for a parent in the frontier bitmap), chosen
+// by how many edges each direction would touch, and run across the pool.
+//
+// Graph::bfs answers with the first route its FIFO queue finds, so the
+// parent of v is the earliest-dequeued vertex with an edge to v, and its
+// first such edge. Here every vertex gets a rank in that same dequeue
+// order and the parent is picked by the smallest (rank, edge position)
+// key, so both engines return exactly the same path. The price is that
+// bottom-up steps scan all incoming edges instead of stopping at the
+// first frontier hit, but those scans are bit tests on contiguous arrays.
+//
+class DirectionOptimizingBFS {
+    const FlatGraph& graph;
+    ThreadPool& pool;
+
+    // Incoming edges of v: inSource[k] and the position of the edge in
+    // the source's out-list, for k in inOffsets[v] .. inOffsets[v + 1] - 1.
+    int* inOffsets;
+    int* inSource;
+    int* inPos;
+
+    static const uint64_t NONE = ~(uint64_t)0;
+
+    // Switch to bottom-up once the frontier's edges exceed 1/ALPHA of the
+    // unexplored edges, and back once it holds fewer than n/BETA vertices.
+    static const int ALPHA = 14;
+    static const int BETA = 24;
+
+    static uint64_t pack(int rank, int pos) {
+        return ((uint64_t)(uint32_t)rank << 32) | (uint32_t)pos;
+    }
+
+    static bool testBit(const std::atomic<uint64_t>* bits, int v) {
+        return (bits[v >> 6].load(std::memory_order_relaxed) >> (v & 63)) & 1;
+    }
+
+public:
+    DirectionOptimizingBFS(const FlatGraph& g, ThreadPool& p)
+        : graph(g), pool(p)
+    {
+        int n = graph.n;
+        inOffsets = new int[n + 1];
+        inSource = new int[graph.m];
+        inPos = new int[graph.m];
+
+        for (int v = 0; v <= n; v++)
+            inOffsets[v] = 0;
+        for (int e = 0; e < graph.m; e++)
+            inOffsets[graph.targets[e] + 1]++;
+        for (int v = 0; v < n; v++)
+            inOffsets[v + 1] += inOffsets[v];
+
+        int* fill = new int[n];
+        for (int v = 0; v < n; v++)
+            fill[v] = inOffsets[v];
+
+        for (int u = 0; u < n; u++) {
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int k = fill[graph.targets[e]]++;
+                inSource[k] = u;
+                inPos[k] = e - graph.offsets[u];
+            }
+        }
+        delete[] fill;
+    }
+
+    DirectionOptimizingBFS(const DirectionOptimizingBFS&) = delete;
+    DirectionOptimizingBFS& operator=(const DirectionOptimizingBFS&) = delete;
+
+    ~DirectionOptimizingBFS() {
+        delete[] inOffsets;
+        delete[] inSource;
+        delete[] inPos;
+    }
+
+    // Hop-minimal route from source to dest, or an empty one if dest
+    // cannot be reached (or the search was cancelled through `control`).
+    Route route(int source, int dest, SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
+        int n = graph.n;
+        int words = (n + 63) / 64;
+        int threads = pool.size();
+
+        std::atomic<uint64_t>* visited = new std::atomic<uint64_t>[words];
+        std::atomic<uint64_t>* frontierBits = new std::atomic<uint64_t>[words];
+        std::atomic<uint64_t>* nextBits = new std::atomic<uint64_t>[words];
+        for (int i = 0; i < words; i++) {
+            visited[i].store(0, std::memory_order_relaxed);
+            frontierBits[i].store(0, std::memory_order_relaxed);
+            nextBits[i].store(0, std::memory_order_relaxed);
+        }
+
+        // key[v]: (rank of parent, edge position) that discovered v.
+        // order[r]: vertex with dequeue rank r; rank[v] is the inverse.
+        std::atomic<uint64_t>* key = new std::atomic<uint64_t>[n];
+        int* order = new int[n];
+        int* rank = new int[n];
+        for (int v = 0; v < n; v++)
+            key[v].store(NONE, std::memory_order_relaxed);
+
+        ArrayList<int>* found = new ArrayList<int>[threads];
+        long* scanned = new long[threads];
+        for (int t = 0; t < threads; t++) scanned[t] = 0;
+        long expanded = 0, peak = 1;
+
+        order[0] = source;
+        rank[source] = 0;
+        visited[source >> 6].fetch_or((uint64_t)1 << (source & 63));
+
+        int levelStart = 0, levelEnd = 1;
+        long long unexplored = graph.m - graph.degree(source);
+        bool bottomUp = false;
+
+        while (levelStart < levelEnd && !testBit(visited, dest)) {
+            if (control && control->check(expanded))
+                break;
+
+            long long frontierEdges = 0;
+            for (int r = levelStart; r < levelEnd; r++)
+                frontierEdges += graph.degree(order[r]);
+
+            int frontierSize = levelEnd - levelStart;
+            expanded += frontierSize;
+            if (frontierSize > peak) peak = frontierSize;
+            if (!bottomUp && frontierEdges > unexplored / ALPHA)
+                bottomUp = true;
+            else if (bottomUp && frontierSize < n / BETA)
+                bottomUp = false;
+
+            if (bottomUp) {
+                for (int i = 0; i < words; i++)
+                    frontierBits[i].store(0, std::memory_order_relaxed);
+                for (int r = levelStart; r < levelEnd; r++)
+                    frontierBits[order[r] >> 6].fetch_or(
+                        (uint64_t)1 << (order[r] & 63), std::memory_order_relaxed);
+
+                // One 64-vertex word per iteration, so each word of
+                // nextBits has a single writer.
+                pool.parallelFor(0, words, [&](int w, int worker) {
+                    uint64_t unseen = ~visited[w].load(std::memory_order_relaxed);
+                    uint64_t hits = 0;
+
+                    while (unseen) {
+                        int bit = __builtin_ctzll(unseen);
+                        unseen &= unseen - 1;
+
+                        int v = w * 64 + bit;
+                        if (v >= n) break;
+
+                        uint64_t best = NONE;
+                        scanned[worker] += inOffsets[v + 1] - inOffsets[v];
+                        for (int k = inOffsets[v]; k < inOffsets[v + 1]; k++) {
+                            int u = inSource[k];
+                            if (!testBit(frontierBits, u)) continue;
+
+                            uint64_t candidate = pack(rank[u], inPos[k]);
+                            if (candidate < best) best = candidate;
+                        }
+
+                        if (best != NONE) {
+                            key[v].store(best, std::memory_order_relaxed);
+                            hits |= (uint64_t)1 << bit;
+                            found[worker].append(v);
+                        }
+                    }
+                    nextBits[w].store(hits, std::memory_order_relaxed);
+                }, 16);
+            } else {
+                pool.parallelFor(levelStart, levelEnd, [&](int r, int worker) {
+                    int u = order[r];
+                    int base = graph.offsets[u];
+                    scanned[worker] += graph.degree(u);
+
+                    for (int e = base; e < graph.offsets[u + 1]; e++) {
+                        int v = graph.targets[e];
+                        if (testBit(visited, v)) continue;
+
+                        uint64_t candidate = pack(r, e - base);
+                        uint64_t cur = key[v].load(std::memory_order_relaxed);
+                        while (candidate < cur &&
+                               !key[v].compare_exchange_weak(
+                                   cur, candidate, std::memory_order_relaxed)) {}
+
+                        uint64_t bit = (uint64_t)1 << (v & 63);
+                        if (!(nextBits[v >> 6].fetch_or(bit) & bit))
+                            found[worker].append(v);
+                    }
+                }, 16);
+            }
+
+            // Rank the new level in the order Graph::bfs would enqueue it.
+            int next = levelEnd;
+            for (int t = 0; t < threads; t++) {
+                for (int i = 0; i < found[t].size(); i++) {
+                    int v = found[t][i];
+                    order[next++] = v;
+                    unexplored -= graph.degree(v);
+                }
+                found[t] = ArrayList<int>();
+            }
+
+            mergeSort(order + levelEnd, next - levelEnd, [&](int a, int b) {
+                return key[a].load(std::memory_order_relaxed) <
+                       key[b].load(std::memory_order_relaxed);
+            });
+
+            for (int r = levelEnd; r < next; r++)
+                rank[order[r]] = r;
+
+            for (int i = 0; i < words; i++) {
+                uint64_t bits = nextBits[i].exchange(0, std::memory_order_relaxed);
+                visited[i].fetch_or(bits, std::memory_order_relaxed);
+            }
+
+            levelStart = levelEnd;
+            levelEnd = next;
+        }
+
+        Route result;
+        SearchStats& stats = result.stats;
+        stats.nodesExpanded = expanded;
+        stats.peakFrontier = peak;
+        for (int t = 0; t < threads; t++)
+            stats.edgesRelaxed += scanned[t];
+        stats.searchMs = millisSince(started);
+
+        // The key of each vertex names its parent's rank and the edge
+        // position in the parent's row, which is exactly a Route leg.
+        auto extracting = std::chrono::steady_clock::now();
+        if (testBit(visited, dest)) {
+            int hops = 0;
+            for (int v = dest; v != source; v = order[key[v].load() >> 32])
+                hops++;
+
+            for (int i = 0; i <= hops; i++) result.vertices.append(0);
+            for (int i = 0; i < hops; i++) result.legs.append(0);
+
+            int i = hops;
+            for (int v = dest; v != source; i--) {
+                uint64_t k = key[v].load(std::memory_order_relaxed);
+                result.vertices[i] = v;
+                result.legs[i - 1] = (int)(uint32_t)k;
+                v = order[k >> 32];
+            }
+            result.vertices[0] = source;
+
+            graph.finishRoute(result);
+        }
+        stats.extractMs = millisSince(extracting);
+
+        delete[] visited;
+        delete[] frontierBits;
+        delete[] nextBits;
+        delete[] key;
+        delete[] order;
+        delete[] rank;
+        delete[] found;
+        delete[] scanned;
+
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+//
+// ─── HARDWARE CACHE-MISS COUNTER ───────────────────────────────────────
+//
+// Counts last-level cache misses of the calling thread between start()
+// and stop() through perf_event_open. Where the kernel does not allow it
+// (containers, non-Linux, perf_event_paranoid) available() is false and
+// the benchmarks print "n/a" instead.
+//
+class PerfCounter {
+    int fd;
+
+public:
+    PerfCounter() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long misses = -1;
+#ifdef __linux__
+        if (fd < 0) return misses;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &misses, sizeof(misses)) != sizeof(misses))
+            misses = -1;
+#endif
+        return misses;
+    }
+};
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef QUERY_LOG_H
+#define QUERY_LOG_H
+
+#include <ArrayList.h>
+#include <Graph.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+
+//
+// ─── QUERY RECORDS ─────────────────────────────────────────────────────
+//
+// One answered query. Modes are numbered as in the UI dropdown and
+// RouteMode: 0 cheapest price, 1 shortest time, 2 fewest stops. The
+// timestamp is wall-clock microseconds since the Unix epoch at which the
+// query was asked; latency is what the search itself took.
+//
+// start and dest are vertex ids, which only mean something on the
+// network the query was answered on: `network` is that network's
+// fingerprint (see networkFingerprint), 0 if unknown.
+//
+enum QueryFlags { QUERY_FOUND = 1, QUERY_CACHE_HIT = 2, QUERY_MULTI = 4, QUERY_NETWORK = 8 };
+
+struct QueryRecord {
+    long long timestampUs;
+    int start;
+    int dest;
+    int latencyUs;
+    int nodesExpanded;
+    int mode;
+    int flags;
+    uint64_t network;
+
+    bool found() const { return flags & QUERY_FOUND; }
+};
+
+// Identifies a network by its airports: FNV-1a over the airport count
+// and every name in vertex order. Any edit to vertices.csv that moves,
+// adds, drops or renames an airport changes it.
+inline uint64_t networkFingerprint(const Graph& g) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    int n = g.vertices.size();
+    for (int b = 0; b < 4; b++)
+        h = (h ^ (unsigned char)(n >> (8 * b))) * 0x100000001b3ULL;
+
+    for (int v = 0; v < n; v++) {
+        const std::string& name = g.vertices[v]->data;
+        for (int i = 0; i < (int)name.size(); i++)
+            h = (h ^ (unsigned char)name[i]) * 0x100000001b3ULL;
+        h = (h ^ 0) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+//
+// ─── QUERY LOG FORMAT ──────────────────────────────────────────────────
+//
+// Native-endian binary: an 8-byte magic, then fixed 26-byte records
+// (timestamp 8, start 4, dest 4, latency 4, nodes expanded 4, mode 1,
+// flags 1), so a log is appended to with plain writes. A record flagged
+// QUERY_NETWORK is a marker, not a query: its timestamp field holds the
+// fingerprint of the network the queries after it were answered on. A record torn
+// by a crash is cut off by the next QueryRecorder to open the log, so
+// what it appends stays on record boundaries.
+//
+const char QUERY_LOG_MAGIC[8] = { 'F', 'L', 'T', 'Q', 'L', 'O', 'G', '2' };
+const int QUERY_RECORD_BYTES = 26;
+
+inline void packQueryRecord(const QueryRecord& r, char* out) {
+    int64_t timestamp = r.timestampUs;
+    int32_t ints[4] = { r.start, r.dest, r.latencyUs, r.nodesExpanded };
+    memcpy(out, &timestamp, 8);
+    memcpy(out + 8, ints, 16);
+    out[24] = (char)r.mode;
+    out[25] = (char)r.flags;
+}
+
+inline QueryRecord unpackQueryRecord(const char* in) {
+    int64_t timestamp;
+    int32_t ints[4];
+    memcpy(&timestamp, in, 8);
+    memcpy(ints, in + 8, 16);
+
+    QueryRecord r;
+    r.timestampUs = timestamp;
+    r.start = ints[0];
+    r.dest = ints[1];
+    r.latencyUs = ints[2];
+    r.nodesExpanded = ints[3];
+    r.mode = (unsigned char)in[24];
+    r.flags = (unsigned char)in[25];
+    r.network = 0;
+    return r;
+}
+
+inline QueryRecord networkMarker(uint64_t fingerprint) {
+    QueryRecord r;
+    r.timestampUs = (long long)fingerprint;
+    r.start = r.dest = r.latencyUs = r.nodesExpanded = r.mode = 0;
+    r.flags = QUERY_NETWORK;
+    r.network = fingerprint;
+    return r;
+}
+
+// Appends every whole query of `filename` to `out`, each with the
+// network of the marker before it. False if the file cannot be read or
+// is not a query log.
+inline bool readQueryLog(const std::string& filename, ArrayList<QueryRecord>& out) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[8];
+    if (!file.read(magic, 8) || memcmp(magic, QUERY_LOG_MAGIC, 8) != 0)
+        return false;
+
+    char buffer[QUERY_RECORD_BYTES];
+    uint64_t network = 0;
+    while (file.read(buffer, QUERY_RECORD_BYTES)) {
+        QueryRecord r = unpackQueryRecord(buffer);
+        if (r.flags & QUERY_NETWORK) {
+            network = (uint64_t)r.timestampUs;
+            continue;
+        }
+        r.network = network;
+        out.append(r);
+    }
+    return true;
+}
+
+//
+// ─── QUERY RECORDER ────────────────────────────────────────────────────
+//
+// Opt-in append-only recorder. Records are packed into a small buffer
+// under a lock and written out when it fills and on destruction, so
+// recording costs a memcpy per query. Several processes may append to
+// the same log one after another; a file that exists but is not a query
+// log is left alone and nothing is recorded. A torn last record is
+// dropped before appending. A network marker goes in ahead of the first
+// query and whenever the network changes (a reload), so every query can
+// be matched with the airports its ids refer to.
+//
+class QueryRecorder {
+    static const int BUFFERED = 128;
+
+    std::ofstream file;
+    std::mutex lock;
+    char buffer[BUFFERED * QUERY_RECORD_BYTES];
+    int used;
+    long written;
+    bool marked;            // a marker for `network` is in the log
+    uint64_t network;
+
+    void append(const QueryRecord& r) {
+        packQueryRecord(r, buffer + (long)used * QUERY_RECORD_BYTES);
+        if (++used == BUFFERED) flushLocked();
+    }
+
+    void flushLocked() {
+        if (used == 0) return;
+        file.write(buffer, (long)used * QUERY_RECORD_BYTES);
+        file.flush();
+        written += used;
+        used = 0;
+    }
+
+public:
+    explicit QueryRecorder(const std::string& filename)
+        : used(0), written(0), marked(false), network(0) {
+        bool fresh;
+        long size;
+        {
+            std::ifstream existing(filename, std::ios::binary);
+            char magic[8];
+            existing.read(magic, 8);
+            fresh = existing.gcount() == 0;
+            if (!fresh && (existing.gcount() < 8 || memcmp(magic, QUERY_LOG_MAGIC, 8) != 0))
+                return;
+
+            existing.clear();
+            existing.seekg(0, std::ios::end);
+            size = fresh ? 0 : (long)existing.tellg();
+        }
+
+        long whole = size > 8 ? 8 + (size - 8) / QUERY_RECORD_BYTES * QUERY_RECORD_BYTES : size;
+        if (whole != size && truncate(filename.c_str(), whole) != 0)
+            return;
+
+        file.open(filename, std::ios::binary | std::ios::app);
+        if (file.is_open() && fresh) {
+            file.write(QUERY_LOG_MAGIC, 8);
+            file.flush();
+        }
+    }
+
+    QueryRecorder(const QueryRecorder&) = delete;
+    QueryRecorder& operator=(const QueryRecorder&) = delete;
+
+    ~QueryRecorder() {
+        flush();
+    }
+
+    bool isOpen() const { return file.is_open(); }
+
+    void record(const QueryRecord& r) {
+        if (!isOpen()) return;
+
+        std::lock_guard<std::mutex> guard(lock);
+        if (!marked || r.network != network) {
+            append(networkMarker(r.network));
+            marked = true;
+            network = r.network;
+        }
+        append(r);
+    }
+
+    void flush() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (isOpen()) flushLocked();
+    }
+
+    // Records (markers included) handed to the file so far.
+    long recorded() {
+        std::lock_guard<std::mutex> guard(lock);
+        return written + used;
+    }
+
+    static long long nowMicros() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+};
+
+#endif
@@ -3,13 +3,13 @@
 
 #include <LinkedList.h>
 
-template <class T> class Queue;
+template <class T, class Alloc = NodePool<Link<T>>> class Queue;
 
-template <class T>
-std::ostream &operator<<(std::ostream &os, const Queue<T> &q);
+template <class T, class Alloc>
+std::ostream &operator<<(std::ostream &os, const Queue<T, Alloc> &q);
 
-template <class T> class Queue {
-    LinkedList<T> list;
+template <class T, class Alloc> class Queue {
+    LinkedList<T, Alloc> list;
 
 public:
     void enqueue(T value) { list.append(value); }
@@ -22,13 +22,15 @@ public:
 
     int size() { return list.size(); }
 
-    friend std::ostream &operator<< <>(std::ostream &os, const Queue<T> &q);
+    const AllocationStats &allocationStats() const { return list.allocationStats(); }
+
+    friend std::ostream &operator<< <>(std::ostream &os, const Queue<T, Alloc> &q);
 
     friend struct Graph;
 };
 
-template <class T>
-std::ostream &operator<<(std::ostream &os, const Queue<T> &q) {
+template <class T, class Alloc>
+std::ostream &operator<<(std::ostream &os, const Queue<T, Alloc> &q) {
     os << q.list;
 
     return os;
@@ -0,0 +1,233 @@
+#ifndef ROUTE_CACHE_H
+#define ROUTE_CACHE_H
+
+#include <Graph.h>
+#include <cstdint>
+#include <mutex>
+
+//
+// ─── ROUTE CACHE ───────────────────────────────────────────────────────
+//
+// Bounded LRU cache of computed Routes keyed by (start id, dest id, mode),
+// where mode is the "Search Mode" dropdown index. Graph::addEdge always
+// adds both directions with the same weights, so A -> B and B -> A share
+// one entry and a hit in the other direction is served by walking the
+// stored route backwards through Edge::twin. (When several routes tie,
+// the reversed one may differ from what a fresh search would pick, but
+// it costs the same.)
+//
+// Every entry belongs to one Graph::version; the first lookup after the
+// graph changes drops them all.
+//
+// Entries live in a fixed pool linked into a recency list, and an
+// open-addressing table (linear probing, backward-shift deletion) maps
+// keys to pool slots. All operations take an internal lock.
+//
+class RouteCache {
+    struct Entry {
+        int low, high, mode;    // key: endpoints in ascending id order
+        int start;              // which endpoint `route` starts from
+        Route route;
+        int prev, next;         // recency list, -1 terminated
+    };
+
+    const Graph& graph;
+    long version;
+
+    Entry* entries;
+    int capacity;
+    int count;
+    int newest, oldest;
+
+    int* slots;     // entry index or -1
+    int mask;
+
+    long hits, reverseHits, misses, evictions, invalidations;
+    std::mutex lock;
+
+    int home(int low, int high, int mode) const {
+        uint64_t h = ((uint64_t)(uint32_t)low << 32) | (uint32_t)high;
+        h = (h ^ (uint64_t)mode) * 0x9E3779B97F4A7C15ULL;
+        return (int)(h >> 32) & mask;
+    }
+
+    // Slot holding the key, or the empty slot where it would go.
+    int find(int low, int high, int mode) const {
+        int i = home(low, high, mode);
+        while (slots[i] >= 0) {
+            const Entry& e = entries[slots[i]];
+            if (e.low == low && e.high == high && e.mode == mode) return i;
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void unlinkSlot(int i) {
+        int j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (slots[j] < 0) break;
+
+            const Entry& e = entries[slots[j]];
+            int k = home(e.low, e.high, e.mode);
+            bool movable = i <= j ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i] = -1;
+    }
+
+    void detach(int index) {
+        Entry& e = entries[index];
+        if (e.prev >= 0) entries[e.prev].next = e.next; else newest = e.next;
+        if (e.next >= 0) entries[e.next].prev = e.prev; else oldest = e.prev;
+    }
+
+    void pushFront(int index) {
+        entries[index].prev = -1;
+        entries[index].next = newest;
+        if (newest >= 0) entries[newest].prev = index;
+        newest = index;
+        if (oldest < 0) oldest = index;
+    }
+
+    void clearLocked() {
+        for (int i = 0; i <= mask; i++) slots[i] = -1;
+        for (int i = 0; i < count; i++) entries[i].route = Route();
+        count = 0;
+        newest = oldest = -1;
+    }
+
+    void checkVersion() {
+        if (version == graph.version) return;
+        if (count > 0) invalidations++;
+        clearLocked();
+        version = graph.version;
+    }
+
+    Route reversed(const Route& route) const {
+        Route back;
+        int n = route.vertices.size();
+        for (int i = n - 1; i >= 0; i--)
+            back.vertices.append(route.vertices[i]);
+        for (int i = n - 2; i >= 0; i--)
+            back.legs.append(graph.leg(route, i)->twin);
+
+        back.totalPrice = route.totalPrice;
+        back.totalTime = route.totalTime;
+        back.stops = route.stops;
+        return back;
+    }
+
+public:
+    RouteCache(const Graph& g, int size = 256)
+        : graph(g), version(g.version), capacity(size > 0 ? size : 1),
+          count(0), newest(-1), oldest(-1),
+          hits(0), reverseHits(0), misses(0), evictions(0), invalidations(0)
+    {
+        entries = new Entry[capacity];
+
+        int tableSize = 1;
+        while (tableSize < 2 * capacity) tableSize *= 2;
+        slots = new int[tableSize];
+        mask = tableSize - 1;
+        for (int i = 0; i < tableSize; i++) slots[i] = -1;
+    }
+
+    RouteCache(const RouteCache&) = delete;
+    RouteCache& operator=(const RouteCache&) = delete;
+
+    ~RouteCache() {
+        delete[] entries;
+        delete[] slots;
+    }
+
+    // Copies the cached route for start -> dest into `route`, marked as a
+    // cache hit. Returns false on a miss.
+    bool lookup(int start, int dest, int mode, Route& route) {
+        std::lock_guard<std::mutex> guard(lock);
+        checkVersion();
+
+        int low = start < dest ? start : dest;
+        int high = start < dest ? dest : start;
+        int slot = find(low, high, mode);
+        if (slots[slot] < 0) {
+            misses++;
+            return false;
+        }
+
+        int index = slots[slot];
+        detach(index);
+        pushFront(index);
+
+        Entry& e = entries[index];
+        if (e.start == start) {
+            route = e.route;
+        } else {
+            route = reversed(e.route);
+            reverseHits++;
+        }
+        hits++;
+
+        route.stats = SearchStats();
+        route.stats.cacheHit = true;
+        return true;
+    }
+
+    // Remembers a route computed against the current graph version.
+    void store(int start, int dest, int mode, const Route& route) {
+        std::lock_guard<std::mutex> guard(lock);
+        checkVersion();
+
+        int low = start < dest ? start : dest;
+        int high = start < dest ? dest : start;
+        int slot = find(low, high, mode);
+
+        int index;
+        if (slots[slot] >= 0) {
+            index = slots[slot];
+            detach(index);
+        } else {
+            if (count < capacity) {
+                index = count++;
+            } else {
+                index = oldest;
+                detach(index);
+                Entry& victim = entries[index];
+                unlinkSlot(find(victim.low, victim.high, victim.mode));
+                evictions++;
+            }
+            slot = find(low, high, mode);
+            slots[slot] = index;
+        }
+
+        Entry& e = entries[index];
+        e.low = low;
+        e.high = high;
+        e.mode = mode;
+        e.start = start;
+        e.route = route;
+        pushFront(index);
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> guard(lock);
+        clearLocked();
+    }
+
+    int size() const { return count; }
+    long hitCount() const { return hits; }
+    long reverseHitCount() const { return reverseHits; }
+    long missCount() const { return misses; }
+    long evictionCount() const { return evictions; }
+    long invalidationCount() const { return invalidations; }
+
+    double hitRate() const {
+        long total = hits + misses;
+        return total > 0 ? (double)hits / total : 0;
+    }
+};
+
+#endif
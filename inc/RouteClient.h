@@ -0,0 +1,74 @@
+#ifndef ROUTE_CLIENT_H
+#define ROUTE_CLIENT_H
+
+#include <RouteProtocol.h>
+#include <cstring>
+#include <string>
+#include <sys/un.h>
+
+//
+// ─── ROUTE CLIENT ──────────────────────────────────────────────────────
+//
+// Blocking client for RouteServer. query() is one round trip; send() and
+// receive() let a caller pipeline several requests on one connection and
+// match replies by tag. Not thread-safe: use one client per thread.
+//
+class RouteClient {
+    int fd;
+    uint32_t nextTag;
+
+public:
+    RouteClient() : fd(-1), nextTag(1) {}
+
+    RouteClient(const RouteClient&) = delete;
+    RouteClient& operator=(const RouteClient&) = delete;
+
+    ~RouteClient() { disconnect(); }
+
+    bool connect(const std::string& path) {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) return false;
+        strcpy(address.sun_path, path.c_str());
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return false;
+
+        if (::connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    void disconnect() {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+
+    bool isConnected() const { return fd >= 0; }
+
+    // Sends a request and returns its tag (0 on failure).
+    uint32_t send(int start, int dest, RouteMode mode) {
+        RouteRequest request = { nextTag++, start, dest, mode };
+        if (nextTag == 0) nextTag = 1;
+        return writeFully(fd, &request, sizeof(request)) ? request.tag : 0;
+    }
+
+    bool receive(RouteReply& reply) { return readReply(fd, reply); }
+
+    bool query(int start, int dest, RouteMode mode, RouteReply& reply) {
+        return send(start, dest, mode) != 0 && receive(reply);
+    }
+
+    // Number of vertices in the server's graph, or -1.
+    int vertexCount() {
+        RouteReply reply;
+        if (!query(0, 0, MODE_INFO, reply) || reply.header.status != ROUTE_INFO)
+            return -1;
+        return reply.header.count;
+    }
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef ROUTE_ENGINE_H
+#define ROUTE_ENGINE_H
+
+#include <Dijkstra.h>
+#include <ParallelBFS.h>
+#include <RouteProtocol.h>
+
+//
+// ─── ROUTE ENGINE ──────────────────────────────────────────────────────
+//
+// Answers RouteRequests against one FlatGraph for a fixed number of
+// workers. Worker w owns Dijkstra scratch slot w, and fewest-stops goes
+// through a shared DirectionOptimizingBFS on a one-thread pool (which
+// runs inline, with all per-query state on the stack), so different
+// workers can answer at the same time.
+//
+class RouteEngine {
+    const FlatGraph& graph;
+    ThreadPool inlinePool;
+    DirectionOptimizingBFS bfs;
+    Dijkstra** scratch;
+    int workers;
+
+public:
+    RouteEngine(const FlatGraph& g, int workerCount)
+        : graph(g), inlinePool(1), bfs(g, inlinePool), workers(workerCount)
+    {
+        scratch = new Dijkstra*[workers];
+        for (int i = 0; i < workers; i++)
+            scratch[i] = new Dijkstra(graph);
+    }
+
+    RouteEngine(const RouteEngine&) = delete;
+    RouteEngine& operator=(const RouteEngine&) = delete;
+
+    ~RouteEngine() {
+        for (int i = 0; i < workers; i++)
+            delete scratch[i];
+        delete[] scratch;
+    }
+
+    const FlatGraph& flat() const { return graph; }
+
+    void answer(const RouteRequest& request, int worker, RouteReply& reply) {
+        reply.header.tag = request.tag;
+        reply.header.totalPrice = 0;
+        reply.header.totalTime = 0;
+        reply.header.count = 0;
+        reply.path = ArrayList<int>();
+
+        if (request.mode == MODE_INFO) {
+            reply.header.status = ROUTE_INFO;
+            reply.header.count = graph.n;
+            return;
+        }
+
+        if (request.start < 0 || request.start >= graph.n ||
+            request.dest < 0 || request.dest >= graph.n ||
+            request.mode < MODE_PRICE || request.mode > MODE_STOPS) {
+            reply.header.status = ROUTE_BAD_QUERY;
+            return;
+        }
+
+        Route route;
+        if (request.mode == MODE_STOPS) {
+            route = bfs.route(request.start, request.dest);
+        } else {
+            WeightMode mode = request.mode == MODE_PRICE ? USE_PRICE : USE_TIME;
+            route = scratch[worker]->route(request.start, request.dest, mode);
+        }
+
+        if (!route.found()) {
+            reply.header.status = ROUTE_NOT_FOUND;
+            return;
+        }
+
+        reply.header.status = ROUTE_OK;
+        reply.header.totalPrice = route.totalPrice;
+        reply.header.totalTime = route.totalTime;
+        reply.path = route.vertices;
+    }
+};
+
+#endif
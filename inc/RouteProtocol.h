@@ -0,0 +1,126 @@
+#ifndef ROUTE_PROTOCOL_H
+#define ROUTE_PROTOCOL_H
+
+#include <ArrayList.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <sys/socket.h>
+#include <unistd.h>
+
+//
+// ─── ROUTE QUERY WIRE FORMAT ───────────────────────────────────────────
+//
+// Fixed-size records in host byte order (client and server share
+// one machine). A client may pipeline any number of requests; replies
+// carry the request's tag and can come back in any order.
+//
+//   request:  tag, start, dest, mode                    (4 x int32)
+//   reply:    tag, status, totalPrice, totalTime, count (5 x int32)
+//             followed by `count` vertex ids, start to dest
+//
+// MODE_INFO asks for the graph size instead of a route; the reply has
+// status ROUTE_INFO and the vertex count in `count`, with no ids following.
+//
+enum RouteMode {
+    MODE_PRICE = 0,     // same order as the app's "Search Mode" dropdown
+    MODE_TIME  = 1,
+    MODE_STOPS = 2,
+    MODE_INFO  = 3
+};
+
+enum RouteStatus {
+    ROUTE_OK        = 0,
+    ROUTE_NOT_FOUND = 1,
+    ROUTE_BAD_QUERY = 2,
+    ROUTE_INFO      = 3
+};
+
+struct RouteRequest {
+    uint32_t tag;
+    int32_t start;
+    int32_t dest;
+    int32_t mode;
+};
+
+struct RouteReplyHeader {
+    uint32_t tag;
+    int32_t status;
+    int32_t totalPrice;
+    int32_t totalTime;
+    int32_t count;
+};
+
+struct RouteReply {
+    RouteReplyHeader header;
+    ArrayList<int> path;
+};
+
+//
+// ─── BLOCKING SOCKET I/O ───────────────────────────────────────────────
+//
+// Loop until all bytes moved; false on EOF or error. send() uses
+// MSG_NOSIGNAL so a vanished peer is an error, not a SIGPIPE.
+//
+inline bool readFully(int fd, void* buffer, size_t length) {
+    char* p = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t got = read(fd, p, length);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        length -= got;
+    }
+    return true;
+}
+
+inline bool writeFully(int fd, const void* buffer, size_t length) {
+    const char* p = static_cast<const char*>(buffer);
+    while (length > 0) {
+        ssize_t sent = send(fd, p, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+// Header and ids go out in one write so replies from different threads
+// never interleave on the same socket (callers still serialize writes).
+inline bool writeReply(int fd, const RouteReply& reply) {
+    int count = reply.header.status == ROUTE_OK ? reply.path.size() : 0;
+    size_t bytes = sizeof(RouteReplyHeader) + count * sizeof(int32_t);
+    char* buffer = new char[bytes];
+
+    RouteReplyHeader header = reply.header;
+    if (header.status != ROUTE_INFO)
+        header.count = count;
+    *reinterpret_cast<RouteReplyHeader*>(buffer) = header;
+
+    int32_t* ids = reinterpret_cast<int32_t*>(buffer + sizeof(RouteReplyHeader));
+    for (int i = 0; i < count; i++)
+        ids[i] = reply.path[i];
+
+    bool ok = writeFully(fd, buffer, bytes);
+    delete[] buffer;
+    return ok;
+}
+
+inline bool readReply(int fd, RouteReply& reply) {
+    if (!readFully(fd, &reply.header, sizeof(reply.header)))
+        return false;
+
+    reply.path = ArrayList<int>();
+    if (reply.header.status != ROUTE_OK)
+        return true;
+
+    for (int i = 0; i < reply.header.count; i++) {
+        int32_t id;
+        if (!readFully(fd, &id, sizeof(id))) return false;
+        reply.path.append(id);
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef ROUTE_SERVER_H
+#define ROUTE_SERVER_H
+
+#include <RouteEngine.h>
+#include <Sort.h>
+#include <TraceProfiler.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <poll.h>
+#include <string>
+#include <sys/un.h>
+#include <thread>
+
+//
+// ─── ROUTE SERVER ──────────────────────────────────────────────────────
+//
+// Long-lived daemon that answers RouteRequests from local clients over a
+// Unix domain socket. One reader thread per connection queues requests;
+// a dispatcher waits up to `windowMicros` (or until `batchLimit`
+// requests are queued), then answers the whole batch on the pool.
+// Identical (start, dest, mode) requests in a batch are computed once.
+//
+class RouteServer {
+    struct Connection {
+        int fd;
+        std::mutex writeLock;
+        std::mutex lock;
+        std::condition_variable drained;
+        int pending;
+
+        explicit Connection(int socket) : fd(socket), pending(0) {}
+    };
+
+    struct Pending {
+        Connection* connection;
+        RouteRequest request;
+    };
+
+    RouteEngine& engine;
+    ThreadPool& pool;
+    int batchLimit;
+    int windowMicros;
+
+    int listenFd;
+    std::string socketPath;
+    std::atomic<bool> stopping;
+    bool finished;      // all connections closed, dispatcher may exit
+
+    std::mutex queueLock;
+    std::condition_variable queued;
+    ArrayList<Pending> incoming;
+
+    std::mutex connectionsLock;
+    std::condition_variable connectionsDone;
+    ArrayList<Connection*> connections;
+
+    std::atomic<long long> requests;
+    std::atomic<long long> batches;
+    std::atomic<long long> computed;
+
+    static bool lessQuery(const RouteRequest& a, const RouteRequest& b) {
+        if (a.start != b.start) return a.start < b.start;
+        if (a.dest != b.dest) return a.dest < b.dest;
+        return a.mode < b.mode;
+    }
+
+    static bool sameQuery(const RouteRequest& a, const RouteRequest& b) {
+        return a.start == b.start && a.dest == b.dest && a.mode == b.mode;
+    }
+
+    void readLoop(Connection* c) {
+        RouteRequest request;
+        while (readFully(c->fd, &request, sizeof(request))) {
+            {
+                std::lock_guard<std::mutex> guard(c->lock);
+                c->pending++;
+            }
+            {
+                std::lock_guard<std::mutex> guard(queueLock);
+                incoming.append({ c, request });
+            }
+            queued.notify_one();
+        }
+
+        // Replies still owed to this client must go out (or fail) before
+        // the socket can be closed and the connection freed.
+        {
+            std::unique_lock<std::mutex> guard(c->lock);
+            c->drained.wait(guard, [&] { return c->pending == 0; });
+        }
+        close(c->fd);
+
+        std::lock_guard<std::mutex> guard(connectionsLock);
+        for (int i = 0; i < connections.size(); i++) {
+            if (connections[i] == c) {
+                connections[i] = connections[connections.size() - 1];
+                connections.removeLast();
+                break;
+            }
+        }
+        delete c;
+        connectionsDone.notify_all();
+    }
+
+    void answerBatch(ArrayList<Pending>& batch) {
+        TRACE_SCOPE("answer batch");
+        int n = batch.size();
+        requests += n;
+        batches++;
+
+        // Sort by query so duplicates sit together, then answer each
+        // distinct query once and fan the reply out.
+        int* order = new int[n];
+        for (int i = 0; i < n; i++) order[i] = i;
+        mergeSort(order, n, [&](int a, int b) {
+            return lessQuery(batch[a].request, batch[b].request);
+        });
+
+        int* owner = new int[n];
+        ArrayList<int> distinct;
+        for (int i = 0; i < n; i++) {
+            if (i == 0 || !sameQuery(batch[order[i]].request, batch[order[i - 1]].request))
+                distinct.append(order[i]);
+            owner[order[i]] = distinct.size() - 1;
+        }
+        computed += distinct.size();
+
+        RouteReply* replies = new RouteReply[distinct.size()];
+        pool.parallelFor(0, distinct.size(), [&](int i, int worker) {
+            engine.answer(batch[distinct[i]].request, worker, replies[i]);
+        }, 1);
+
+        for (int i = 0; i < n; i++) {
+            Connection* c = batch[i].connection;
+            RouteReply& reply = replies[owner[i]];
+            reply.header.tag = batch[i].request.tag;
+            {
+                std::lock_guard<std::mutex> guard(c->writeLock);
+                writeReply(c->fd, reply);
+            }
+
+            std::lock_guard<std::mutex> guard(c->lock);
+            if (--c->pending == 0)
+                c->drained.notify_all();
+        }
+
+        delete[] order;
+        delete[] owner;
+        delete[] replies;
+    }
+
+    void dispatchLoop() {
+        TraceProfiler::nameThread("dispatcher");
+        while (true) {
+            ArrayList<Pending> batch;
+            {
+                std::unique_lock<std::mutex> guard(queueLock);
+                queued.wait(guard, [&] { return finished || incoming.size() > 0; });
+                if (incoming.size() == 0) return;
+
+                // Give concurrent clients a moment to join this batch.
+                queued.wait_for(guard, std::chrono::microseconds(windowMicros),
+                                [&] { return stopping || incoming.size() >= batchLimit; });
+
+                batch = incoming;
+                incoming = ArrayList<Pending>();
+            }
+            answerBatch(batch);
+        }
+    }
+
+public:
+    // `engine` must have been built for at least pool.size() workers.
+    RouteServer(RouteEngine& e, ThreadPool& p, int limit = 256, int window = 200)
+        : engine(e), pool(p), batchLimit(limit), windowMicros(window),
+          listenFd(-1), stopping(false), finished(false),
+          requests(0), batches(0), computed(0)
+    {}
+
+    RouteServer(const RouteServer&) = delete;
+    RouteServer& operator=(const RouteServer&) = delete;
+
+    ~RouteServer() {
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+    }
+
+    bool listen(const std::string& path) {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) return false;
+        strcpy(address.sun_path, path.c_str());
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) return false;
+
+        unlink(path.c_str());
+        if (bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 ||
+            ::listen(listenFd, 128) < 0) {
+            close(listenFd);
+            listenFd = -1;
+            return false;
+        }
+
+        socketPath = path;
+        return true;
+    }
+
+    // Accepts clients until stop() is called, then drains every open
+    // connection before returning.
+    void serve() {
+        std::thread dispatcher(&RouteServer::dispatchLoop, this);
+
+        while (!stopping) {
+            pollfd waiting = { listenFd, POLLIN, 0 };
+            if (poll(&waiting, 1, 200) <= 0) continue;
+
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) continue;
+
+            Connection* c = new Connection(fd);
+            {
+                std::lock_guard<std::mutex> guard(connectionsLock);
+                connections.append(c);
+            }
+            std::thread(&RouteServer::readLoop, this, c).detach();
+        }
+
+        {
+            std::unique_lock<std::mutex> guard(connectionsLock);
+            for (int i = 0; i < connections.size(); i++)
+                shutdown(connections[i]->fd, SHUT_RD);
+            connectionsDone.wait(guard, [&] { return connections.size() == 0; });
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(queueLock);
+            finished = true;
+        }
+        queued.notify_all();
+        dispatcher.join();
+    }
+
+    // Safe to call from a signal handler.
+    void stop() {
+        stopping = true;
+    }
+
+    long long requestCount() const { return requests; }
+    long long batchCount() const { return batches; }
+    long long computedCount() const { return computed; }
+};
+
+#endif
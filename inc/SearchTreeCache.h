@@ -0,0 +1,183 @@
+#ifndef SEARCH_TREE_CACHE_H
+#define SEARCH_TREE_CACHE_H
+
+#include <FlatGraph.h>
+#include <MinHeap.h>
+#include <TraceProfiler.h>
+#include <climits>
+
+//
+// ─── SEARCH TREE CACHE ─────────────────────────────────────────────────
+//
+// Users tend to keep the start airport and click through destinations.
+// Instead of restarting Dijkstra for every click, this keeps the search
+// state of the most recent (source, mode) pairs: tentative distances,
+// predecessor edges, which vertices are settled, and the heap.
+//
+// A query for a destination that is already settled just walks the
+// predecessors. Otherwise the stored search carries on from where it
+// stopped until the destination is settled (or the graph is exhausted),
+// so every vertex is settled at most once per source and mode. A
+// cancelled query leaves the state consistent and the next one resumes.
+//
+// Trees belong to the FlatGraph snapshot they were grown on. One thread
+// at a time.
+//
+class SearchTreeCache {
+    struct Tree {
+        int source;         // -1 while unused
+        WeightMode mode;
+        int* dist;
+        int* predEdge;
+        char* settled;
+        MinHeap heap;
+        long settledCount;
+        long lastUse;
+
+        explicit Tree(int n)
+            : source(-1), mode(USE_PRICE), dist(new int[n]),
+              predEdge(new int[n]), settled(new char[n]), heap(n),
+              settledCount(0), lastUse(0) {}
+
+        Tree(const Tree&) = delete;
+        Tree& operator=(const Tree&) = delete;
+
+        ~Tree() {
+            delete[] dist;
+            delete[] predEdge;
+            delete[] settled;
+        }
+    };
+
+    const FlatGraph& graph;
+    Tree** trees;
+    int capacity;
+    long clock;
+
+    long hits, resumes, restarts;
+
+    void reset(Tree& tree, int source, WeightMode mode) {
+        for (int v = 0; v < graph.n; v++) {
+            tree.dist[v] = INT_MAX;
+            tree.predEdge[v] = -1;
+            tree.settled[v] = 0;
+        }
+        tree.heap.clear();
+        tree.source = source;
+        tree.mode = mode;
+        tree.settledCount = 0;
+
+        tree.dist[source] = 0;
+        tree.heap.push(source, 0);
+    }
+
+    // The tree for (source, mode), recycling the least recently used one.
+    Tree& treeFor(int source, WeightMode mode) {
+        Tree* oldest = trees[0];
+        for (int i = 0; i < capacity; i++) {
+            Tree* t = trees[i];
+            if (t->source == source && t->mode == mode) return *t;
+            if (t->lastUse < oldest->lastUse) oldest = t;
+        }
+
+        restarts++;
+        reset(*oldest, source, mode);
+        return *oldest;
+    }
+
+public:
+    SearchTreeCache(const FlatGraph& g, int trees = 8)
+        : graph(g), capacity(trees > 0 ? trees : 1), clock(0),
+          hits(0), resumes(0), restarts(0)
+    {
+        this->trees = new Tree*[capacity];
+        for (int i = 0; i < capacity; i++)
+            this->trees[i] = new Tree(g.n);
+    }
+
+    SearchTreeCache(const SearchTreeCache&) = delete;
+    SearchTreeCache& operator=(const SearchTreeCache&) = delete;
+
+    ~SearchTreeCache() {
+        for (int i = 0; i < capacity; i++)
+            delete trees[i];
+        delete[] trees;
+    }
+
+    // Cheapest route from source to dest, or an empty one if dest cannot
+    // be reached (or the search was cancelled through `control`). Stats
+    // count only the work done by this call.
+    Route route(int source, int dest, WeightMode mode,
+                SearchControl* control = nullptr) {
+        auto started = std::chrono::steady_clock::now();
+        Route result;
+        SearchStats& stats = result.stats;
+
+        Tree& tree = treeFor(source, mode);
+        tree.lastUse = ++clock;
+
+        if (tree.settled[dest]) hits++;
+        else if (tree.settledCount > 0) resumes++;
+
+        const int* w = graph.weights(mode);
+        while (!tree.settled[dest] && !tree.heap.isEmpty()) {
+            if (control && control->check(stats.nodesExpanded))
+                break;
+            if (tree.heap.size() > stats.peakFrontier)
+                stats.peakFrontier = tree.heap.size();
+
+            int u = tree.heap.pop();
+            tree.settled[u] = 1;
+            tree.settledCount++;
+            stats.nodesExpanded++;
+
+            int du = tree.dist[u];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+                int v = graph.targets[e];
+                int dv = du + w[e];
+                stats.edgesRelaxed++;
+                if (dv < tree.dist[v]) {
+                    tree.dist[v] = dv;
+                    tree.predEdge[v] = e;
+                    tree.heap.push(v, dv);
+                }
+            }
+        }
+        stats.searchMs = millisSince(started);
+
+        auto extracting = std::chrono::steady_clock::now();
+        if (tree.settled[dest]) {
+            TRACE_SCOPE("path extraction");
+            ArrayList<int> reversed;
+            for (int v = dest; v != source; v = graph.edgeSource(tree.predEdge[v]))
+                reversed.append(tree.predEdge[v]);
+
+            ArrayList<int> edges;
+            result.vertices.append(source);
+            for (int i = reversed.size() - 1; i >= 0; i--) {
+                edges.append(reversed[i]);
+                result.vertices.append(graph.targets[reversed[i]]);
+            }
+            graph.setLegs(result, edges);
+        }
+        stats.extractMs = millisSince(extracting);
+
+        return result;
+    }
+
+    // Drops every stored tree, e.g. after the weights were changed.
+    void clear() {
+        for (int i = 0; i < capacity; i++) {
+            trees[i]->source = -1;
+            trees[i]->lastUse = 0;
+        }
+    }
+
+    // Queries answered from an already settled vertex, queries that
+    // continued an existing search, and searches started from scratch.
+    long hitCount() const { return hits; }
+    long resumeCount() const { return resumes; }
+    long restartCount() const { return restarts; }
+};
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef SEARCH_WORKER_H
+#define SEARCH_WORKER_H
+
+#include <FlightData.h>
+#include <TraceProfiler.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//
+// ─── SEARCH JOB ────────────────────────────────────────────────────────
+//
+// One query from the UI. modeIndex follows the "Search Mode" dropdown:
+// 0 cheapest price, 1 shortest time, 2 fewest stops. `context` is handed
+// back untouched with the finished job.
+//
+// With a budget of 0 or more the job asks for everything reachable from
+// start within that budget (in the mode's unit) instead of a route to
+// dest; the answer goes to `reachable`.
+//
+// alsoStart / alsoDest list more acceptable airports (vertex ids); the
+// route then runs from whichever start is best to whichever destination
+// is closest.
+//
+// `data` is the version of the network the job runs on; start, dest and
+// the answer's vertex ids all belong to it, and holding it keeps it
+// alive after a reload until the job is gone.
+//
+struct SearchJob {
+    long id;
+    Vertex* start;
+    Vertex* dest;
+    int modeIndex;
+    void* context;
+    int budget;
+    long long askedUs;  // wall clock when asked, for the query log
+    SnapshotRef<FlightData> data;
+
+    SearchControl control;
+    Route result;
+    ArrayList<Reachable> reachable;
+    ArrayList<int> alsoStart;
+    ArrayList<int> alsoDest;
+
+    SearchJob(long i, const SnapshotRef<FlightData>& on, Vertex* s, Vertex* d, int m, void* ctx)
+        : id(i), start(s), dest(d), modeIndex(m), context(ctx), budget(-1), askedUs(0),
+          data(on) {}
+
+    bool isBudget() const { return budget >= 0; }
+    bool isMulti() const { return alsoStart.size() > 0 || alsoDest.size() > 0; }
+
+    bool cancelled() const { return control.cancelled.load(); }
+};
+
+//
+// ─── SEARCH WORKER ─────────────────────────────────────────────────────
+//
+// Background thread that runs one SearchJob at a time. submit() cancels
+// the job in progress and replaces any job still waiting, so only the
+// latest query gets the CPU. Every submitted job, finished or cancelled,
+// is passed to `done` exactly once, from whichever thread retired it;
+// `done` then owns the job. Once the worker is being destroyed, jobs are
+// deleted instead: whatever `done` would hand them to may be going away
+// too. Each job searches with the engines of its own FlightData.
+//
+class SearchWorker {
+    void (*done)(SearchJob*);
+
+    std::thread thread;
+    std::mutex lock;
+    std::condition_variable wake;
+    SearchJob* pending;
+    SearchJob* running;
+    bool stopping;
+
+    void loop() {
+        TraceProfiler::nameThread("search worker");
+        while (true) {
+            SearchJob* job;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || pending; });
+                if (stopping) return;
+
+                job = running = pending;
+                pending = nullptr;
+            }
+
+            if (job->isBudget())
+                runBudget(job);
+            else if (job->isMulti())
+                runMulti(job);
+            else
+                runRoute(job);
+
+            bool shutdown;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                running = nullptr;
+                shutdown = stopping;
+            }
+            if (shutdown)
+                delete job;
+            else
+                done(job);
+        }
+    }
+
+    void runRoute(SearchJob* job) {
+        TRACE_SCOPE("search route");
+        FlightData& data = *job->data;
+        int s = job->start->id, d = job->dest->id;
+        if (job->modeIndex == 0)
+            job->result = data.cheapest->route(s, d, USE_PRICE, &job->control);
+        else if (job->modeIndex == 1)
+            job->result = data.cheapest->route(s, d, USE_TIME, &job->control);
+        else
+            job->result = data.fewestStops->route(s, d, &job->control);
+    }
+
+    void runMulti(SearchJob* job) {
+        TRACE_SCOPE("search any-to-any");
+        ArrayList<int> sources = job->alsoStart;
+        ArrayList<int> targets = job->alsoDest;
+        sources.append(job->start->id);
+        targets.append(job->dest->id);
+
+        Dijkstra& anyToAny = *job->data->anyToAny;
+        if (job->modeIndex == 0)
+            job->result = anyToAny.route(sources, targets, USE_PRICE, &job->control);
+        else if (job->modeIndex == 1)
+            job->result = anyToAny.route(sources, targets, USE_TIME, &job->control);
+        else
+            job->result = anyToAny.fewestStops(sources, targets, &job->control);
+    }
+
+    // Dropdown index 0/1/2 lines up with BUDGET_PRICE/TIME/STOPS.
+    void runBudget(SearchJob* job) {
+        TRACE_SCOPE("search within budget");
+        BudgetUnit unit = (BudgetUnit)job->modeIndex;
+        job->result.stats = job->data->within->run(job->start->id, unit, job->budget,
+                                                   job->reachable, &job->control);
+    }
+
+public:
+    explicit SearchWorker(void (*finished)(SearchJob*))
+        : done(finished), pending(nullptr), running(nullptr), stopping(false)
+    {
+        thread = std::thread(&SearchWorker::loop, this);
+    }
+
+    SearchWorker(const SearchWorker&) = delete;
+    SearchWorker& operator=(const SearchWorker&) = delete;
+
+    // Cancels outstanding work and joins the thread. The running job and
+    // any still waiting are deleted, not passed to `done`.
+    ~SearchWorker() {
+        SearchJob* dropped;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+            if (running) running->control.cancelled = true;
+            dropped = pending;
+            pending = nullptr;
+        }
+        wake.notify_one();
+        thread.join();
+        delete dropped;
+    }
+
+    void submit(SearchJob* job) {
+        SearchJob* dropped;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (running) running->control.cancelled = true;
+            dropped = pending;
+            pending = job;
+        }
+        wake.notify_one();
+
+        if (dropped) {
+            dropped->control.cancelled = true;
+            done(dropped);
+        }
+    }
+
+    // Cancels the running job and drops the waiting one, if any.
+    void cancel() {
+        SearchJob* dropped;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (running) running->control.cancelled = true;
+            dropped = pending;
+            pending = nullptr;
+        }
+
+        if (dropped) {
+            dropped->control.cancelled = true;
+            done(dropped);
+        }
+    }
+
+    bool isBusy() {
+        std::lock_guard<std::mutex> guard(lock);
+        return running || pending;
+    }
+
+    // Nodes expanded so far by the running job.
+    long progress() {
+        std::lock_guard<std::mutex> guard(lock);
+        return running ? running->control.expanded.load() : 0;
+    }
+};
+
+#endif
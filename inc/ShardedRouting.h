@@ -0,0 +1,785 @@
+#ifndef SHARDED_ROUTING_H
+#define SHARDED_ROUTING_H
+
+#include <FlatGraph.h>
+#include <GraphPartition.h>
+#include <MinHeap.h>
+#include <RouteProtocol.h>
+#include <climits>
+#include <fstream>
+#include <string>
+#include <sys/wait.h>
+
+//
+// ─── SHARD FILES ───────────────────────────────────────────────────────
+//
+// writeShards splits a partitioned graph into one file per part plus an
+// overlay file, so that no process after it needs the whole network:
+//
+//   <prefix>-<k>.csv      "vertices,edges", then "id,boundary" per
+//                          vertex of part k, then "from,to,price,time"
+//                          per route inside it (global ids, once each)
+//   <prefix>-overlay.csv  "vertices,parts,cut", then the part of every
+//                          vertex in id order, then "from,to,price,time"
+//                          per route between parts
+//
+inline std::string shardFile(const std::string& prefix, int k) {
+    return prefix + "-" + std::to_string(k) + ".csv";
+}
+
+inline std::string overlayFile(const std::string& prefix) {
+    return prefix + "-overlay.csv";
+}
+
+inline bool writeShards(const FlatGraph& g, const Partition& p, const std::string& prefix) {
+    std::ofstream overlay(overlayFile(prefix));
+    if (!overlay.is_open()) return false;
+
+    overlay << g.n << ',' << p.parts << ',' << p.cutEdges << '\n';
+    for (int v = 0; v < g.n; v++)
+        overlay << p.part[v] << '\n';
+
+    for (int k = 0; k < p.parts; k++) {
+        std::ofstream shard(shardFile(prefix, k));
+        if (!shard.is_open()) return false;
+
+        int vertices = 0, edges = 0;
+        for (int u = 0; u < g.n; u++) {
+            if (p.part[u] != k) continue;
+            vertices++;
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++)
+                if (p.part[g.targets[e]] == k && u < g.targets[e]) edges++;
+        }
+
+        shard << vertices << ',' << edges << '\n';
+        for (int u = 0; u < g.n; u++)
+            if (p.part[u] == k) shard << u << ',' << (p.isBoundary(g, u) ? 1 : 0) << '\n';
+
+        // Each route once, from its lower end (Graph keeps both
+        // directions); self-loops never shorten a route.
+        for (int u = 0; u < g.n; u++) {
+            if (p.part[u] != k) continue;
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                if (u >= v) continue;
+                if (p.part[v] == k)
+                    shard << u << ',' << v << ',' << g.price[e] << ',' << g.time[e] << '\n';
+                else
+                    overlay << u << ',' << v << ',' << g.price[e] << ',' << g.time[e] << '\n';
+            }
+        }
+    }
+    return true;
+}
+
+//
+// ─── SHARD GRAPH ───────────────────────────────────────────────────────
+//
+// One part, as a worker holds it: its vertices under local ids (in
+// increasing global id, so global -> local is a binary search), its
+// routes in both directions and its boundary vertices.
+//
+struct ShardGraph {
+    int n;
+    int* global;        // local id -> global id, increasing
+    int* boundary;      // local ids of boundary vertices, increasing
+    int boundaryCount;
+    FlatGraph* graph;
+
+    ShardGraph()
+        : n(0), global(nullptr), boundary(nullptr), boundaryCount(0), graph(nullptr) {}
+
+    ShardGraph(const ShardGraph&) = delete;
+    ShardGraph& operator=(const ShardGraph&) = delete;
+
+    ~ShardGraph() {
+        delete[] global;
+        delete[] boundary;
+        delete graph;
+    }
+
+    // Local id of a global id, -1 if it is not in this shard.
+    int local(int id) const {
+        int lo = 0, hi = n - 1;
+        while (lo <= hi) {
+            int mid = (lo + hi) / 2;
+            if (global[mid] == id) return mid;
+            if (global[mid] < id) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -1;
+    }
+
+    bool load(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) return false;
+
+        char comma;
+        int vertices, edges;
+        if (!(file >> vertices >> comma >> edges)) return false;
+
+        n = vertices;
+        global = new int[n > 0 ? n : 1];
+        boundary = new int[n > 0 ? n : 1];
+        for (int i = 0; i < n; i++) {
+            int flag;
+            if (!(file >> global[i] >> comma >> flag)) return false;
+            if (flag) boundary[boundaryCount++] = i;
+        }
+
+        int* from = new int[edges > 0 ? edges : 1];
+        int* to = new int[edges > 0 ? edges : 1];
+        int* price = new int[edges > 0 ? edges : 1];
+        int* time = new int[edges > 0 ? edges : 1];
+        bool ok = true;
+        for (int i = 0; ok && i < edges; i++) {
+            int a, b;
+            ok = (bool)(file >> a >> comma >> b >> comma >> price[i] >> comma >> time[i]);
+            from[i] = ok ? local(a) : -1;
+            to[i] = ok ? local(b) : -1;
+            ok = ok && from[i] >= 0 && to[i] >= 0;
+        }
+
+        // Both directions, each row in file order.
+        if (ok) {
+            graph = new FlatGraph(n, 2 * edges);
+            for (int v = 0; v <= n; v++) graph->offsets[v] = 0;
+            for (int i = 0; i < edges; i++) {
+                graph->offsets[from[i] + 1]++;
+                graph->offsets[to[i] + 1]++;
+            }
+            for (int v = 0; v < n; v++) graph->offsets[v + 1] += graph->offsets[v];
+
+            int* cursor = new int[n > 0 ? n : 1];
+            for (int v = 0; v < n; v++) cursor[v] = graph->offsets[v];
+            for (int i = 0; i < edges; i++) {
+                int there = cursor[from[i]]++;
+                int back = cursor[to[i]]++;
+                graph->targets[there] = to[i];
+                graph->targets[back] = from[i];
+                graph->price[there] = graph->price[back] = price[i];
+                graph->time[there] = graph->time[back] = time[i];
+            }
+            delete[] cursor;
+        }
+
+        delete[] from;
+        delete[] to;
+        delete[] price;
+        delete[] time;
+        return ok;
+    }
+};
+
+//
+// ─── SHARD PROTOCOL ────────────────────────────────────────────────────
+//
+// Coordinator -> worker requests, fixed size, host byte order (both ends
+// are on one machine). Ids are global; mode is a RouteMode (price, time
+// or stops). A worker answers in order, one reply per request.
+//
+//   SHARD_BOUNDARY  B, B boundary ids, then B x B distances between them
+//                   inside the shard (INT_MAX if none), row by row
+//   SHARD_FROM a b  status, distance from a to each boundary vertex,
+//                   then to b (INT_MAX if b is elsewhere)
+//   SHARD_PATH a b  a RouteReply for the best a -> b path in the shard
+//
+enum ShardRequestKind {
+    SHARD_BOUNDARY = 0,
+    SHARD_FROM     = 1,
+    SHARD_PATH     = 2
+};
+
+struct ShardRequest {
+    int32_t kind;
+    int32_t a;
+    int32_t b;
+    int32_t mode;
+};
+
+inline bool writeInts(int fd, const int* values, int count) {
+    return writeFully(fd, values, count * sizeof(int32_t));
+}
+
+inline bool readInts(int fd, int* values, int count) {
+    return readFully(fd, values, count * sizeof(int32_t));
+}
+
+//
+// ─── SHARD WORKER ──────────────────────────────────────────────────────
+//
+// Answers shard requests for one ShardGraph with one-to-all Dijkstra
+// (unit weights for MODE_STOPS). serve() handles one connection until
+// the coordinator closes it. Runs in a process of its own (see
+// ShardCoordinator::launch) or on any thread with a socket.
+//
+class ShardWorker {
+    const ShardGraph& shard;
+    MinHeap heap;
+    int* dist;
+    int* predEdge;
+    int* stamp;
+    int* wanted;        // == current for vertices the search must settle
+    int current;
+
+    int distance(int v) const { return stamp[v] == current ? dist[v] : INT_MAX; }
+
+    void want(int v) {
+        if (v >= 0) wanted[v] = current;
+    }
+
+    // Dijkstra from local vertex `source`, stopped once `count` vertices
+    // marked with want() have been settled. Call begin() first.
+    void search(int source, int mode, int count) {
+        const FlatGraph& g = *shard.graph;
+        const int* w = mode == MODE_PRICE ? g.price : mode == MODE_TIME ? g.time : nullptr;
+
+        dist[source] = 0;
+        predEdge[source] = -1;
+        stamp[source] = current;
+        heap.push(source, 0);
+
+        while (!heap.isEmpty() && count > 0) {
+            int u = heap.pop();
+            if (wanted[u] == current) count--;
+
+            int du = dist[u];
+            for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                int v = g.targets[e];
+                int dv = du + (w ? w[e] : 1);
+                if (dv < distance(v)) {
+                    dist[v] = dv;
+                    predEdge[v] = e;
+                    stamp[v] = current;
+                    heap.push(v, dv);
+                }
+            }
+        }
+    }
+
+    void begin() {
+        current++;
+        heap.clear();
+    }
+
+    bool sendBoundary(int fd, int mode) {
+        int b = shard.boundaryCount;
+        int* reply = new int[1 + b + (long)b * b];
+        reply[0] = b;
+        for (int i = 0; i < b; i++)
+            reply[1 + i] = shard.global[shard.boundary[i]];
+
+        for (int i = 0; i < b; i++) {
+            begin();
+            for (int j = 0; j < b; j++) want(shard.boundary[j]);
+            search(shard.boundary[i], mode, b);
+            for (int j = 0; j < b; j++)
+                reply[1 + b + (long)i * b + j] = distance(shard.boundary[j]);
+        }
+
+        bool ok = writeInts(fd, reply, 1 + b + b * b);
+        delete[] reply;
+        return ok;
+    }
+
+    bool sendFrom(int fd, int a, int b, int mode) {
+        int count = shard.boundaryCount;
+        int* reply = new int[count + 2];
+        int source = shard.local(a);
+        int target = shard.local(b);
+
+        reply[0] = source < 0 ? ROUTE_BAD_QUERY : ROUTE_OK;
+        for (int i = 0; i <= count; i++)
+            reply[1 + i] = INT_MAX;
+        if (source >= 0) {
+            begin();
+            for (int i = 0; i < count; i++) want(shard.boundary[i]);
+            int goals = count;
+            if (target >= 0 && wanted[target] != current) goals++;
+            want(target);
+            search(source, mode, goals);
+            for (int i = 0; i < count; i++)
+                reply[1 + i] = distance(shard.boundary[i]);
+            if (target >= 0) reply[1 + count] = distance(target);
+        }
+
+        bool ok = writeInts(fd, reply, count + 2);
+        delete[] reply;
+        return ok;
+    }
+
+    bool sendPath(int fd, int a, int b, int mode) {
+        RouteReply reply;
+        reply.header = { 0, ROUTE_OK, 0, 0, 0 };
+
+        int source = shard.local(a);
+        int target = shard.local(b);
+        if (source < 0 || target < 0) {
+            reply.header.status = ROUTE_BAD_QUERY;
+            return writeReply(fd, reply);
+        }
+
+        begin();
+        want(target);
+        search(source, mode, 1);
+        if (distance(target) == INT_MAX) {
+            reply.header.status = ROUTE_NOT_FOUND;
+            return writeReply(fd, reply);
+        }
+
+        const FlatGraph& g = *shard.graph;
+        ArrayList<int> reversed;
+        for (int v = target; predEdge[v] >= 0; v = g.edgeSource(predEdge[v]))
+            reversed.append(predEdge[v]);
+
+        reply.path.append(a);
+        for (int i = reversed.size() - 1; i >= 0; i--) {
+            int e = reversed[i];
+            reply.path.append(shard.global[g.targets[e]]);
+            reply.header.totalPrice += g.price[e];
+            reply.header.totalTime += g.time[e];
+        }
+        return writeReply(fd, reply);
+    }
+
+public:
+    explicit ShardWorker(const ShardGraph& s)
+        : shard(s), heap(s.n > 0 ? s.n : 1), dist(new int[s.n > 0 ? s.n : 1]),
+          predEdge(new int[s.n > 0 ? s.n : 1]), stamp(new int[s.n > 0 ? s.n : 1]),
+          wanted(new int[s.n > 0 ? s.n : 1]), current(0)
+    {
+        for (int v = 0; v < s.n; v++)
+            stamp[v] = wanted[v] = 0;
+    }
+
+    ShardWorker(const ShardWorker&) = delete;
+    ShardWorker& operator=(const ShardWorker&) = delete;
+
+    ~ShardWorker() {
+        delete[] dist;
+        delete[] predEdge;
+        delete[] stamp;
+        delete[] wanted;
+    }
+
+    void serve(int fd) {
+        ShardRequest request;
+        while (readFully(fd, &request, sizeof(request))) {
+            bool ok = false;
+            if (request.kind == SHARD_BOUNDARY)
+                ok = sendBoundary(fd, request.mode);
+            else if (request.kind == SHARD_FROM)
+                ok = sendFrom(fd, request.a, request.b, request.mode);
+            else if (request.kind == SHARD_PATH)
+                ok = sendPath(fd, request.a, request.b, request.mode);
+            if (!ok) return;
+        }
+    }
+};
+
+//
+// ─── SHARD COORDINATOR ─────────────────────────────────────────────────
+//
+// Answers route queries over a sharded network while holding only the
+// part of every vertex, the routes between parts and the overlay. The
+// overlay has a vertex per boundary vertex and two kinds of arcs: the
+// routes between parts, and a clique per shard with the shortest
+// distance inside it between every two of its boundary vertices, one
+// weight per mode, fetched from the workers at launch.
+//
+// A query asks the start's shard for distances from the start to its
+// boundary (and straight to the destination if it is in the same shard)
+// and the destination's shard for distances from its boundary to the
+// destination (routes run both ways at the same cost), both at once. A
+// Dijkstra over the overlay seeded with the first set and finished with
+// the second gives the cost; clique arcs on the winning path are then
+// expanded into airports by their shards, again all requests first and
+// all replies after, so shards work in parallel.
+//
+// Not thread-safe: one query at a time.
+//
+class ShardCoordinator {
+    struct OverlayArc {
+        int from;           // overlay ids (global ids while loading)
+        int to;
+        int weight[3];      // by RouteMode
+        int shard;          // clique of this shard, or -1 for a route between parts
+        int price;          // routes between parts only
+        int time;
+    };
+
+    // One piece of an answer: a path inside `shard` from a to b, or the
+    // route between parts a -> b when shard is -1.
+    struct Segment {
+        int shard;
+        int a;
+        int b;
+        int price;
+        int time;
+    };
+
+    int n;
+    int parts;
+    int* part;
+    ArrayList<OverlayArc> cut;
+
+    int* fds;
+    pid_t* pids;
+    int launched;
+
+    int overlayN;
+    int* overlayId;             // global -> overlay id, -1 if not boundary
+    int* overlayVertex;         // overlay id -> global
+    ArrayList<int>* boundary;   // per shard, overlay ids in the worker's order
+    int* boundaryIndex;         // overlay id -> position in its shard's list
+
+    int* offsets;
+    OverlayArc* arcs;
+
+    MinHeap* heap;
+    int* dist;
+    int* predArc;
+    int* stamp;
+    int current;
+
+    bool request(int shard, int kind, int a, int b, int mode) {
+        ShardRequest r = { kind, a, b, mode };
+        return writeFully(fds[shard], &r, sizeof(r));
+    }
+
+    bool loadOverlay(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file.is_open()) return false;
+
+        char comma;
+        long cutCount;
+        if (!(file >> n >> comma >> parts >> comma >> cutCount)) return false;
+
+        part = new int[n > 0 ? n : 1];
+        for (int v = 0; v < n; v++)
+            if (!(file >> part[v])) return false;
+
+        for (long i = 0; i < cutCount; i++) {
+            OverlayArc arc;
+            if (!(file >> arc.from >> comma >> arc.to >> comma >> arc.price >> comma >> arc.time))
+                return false;
+            arc.shard = -1;
+            arc.weight[MODE_PRICE] = arc.price;
+            arc.weight[MODE_TIME] = arc.time;
+            arc.weight[MODE_STOPS] = 1;
+            cut.append(arc);
+        }
+        return true;
+    }
+
+    // Boundary lists and cliques from every worker, then the overlay CSR.
+    bool buildOverlay() {
+        overlayId = new int[n > 0 ? n : 1];
+        for (int v = 0; v < n; v++)
+            overlayId[v] = -1;
+
+        ArrayList<OverlayArc> all;
+        ArrayList<int> vertices;
+        boundary = new ArrayList<int>[parts];
+
+        for (int p = 0; p < parts; p++)
+            for (int mode = MODE_PRICE; mode <= MODE_STOPS; mode++)
+                if (!request(p, SHARD_BOUNDARY, 0, 0, mode)) return false;
+
+        for (int p = 0; p < parts; p++) {
+            int b = 0;
+            int* ids = nullptr;
+            int* clique[3] = { nullptr, nullptr, nullptr };
+            bool ok = true;
+
+            for (int mode = MODE_PRICE; ok && mode <= MODE_STOPS; mode++) {
+                ok = readInts(fds[p], &b, 1);
+                if (!ok) break;
+                delete[] ids;
+                ids = new int[b > 0 ? b : 1];
+                clique[mode] = new int[b > 0 ? (long)b * b : 1];
+                ok = readInts(fds[p], ids, b) && readInts(fds[p], clique[mode], b * b);
+            }
+
+            if (ok) {
+                for (int i = 0; i < b; i++) {
+                    overlayId[ids[i]] = vertices.size();
+                    boundary[p].append(vertices.size());
+                    vertices.append(ids[i]);
+                }
+                for (int i = 0; i < b; i++) {
+                    for (int j = 0; j < b; j++) {
+                        long k = (long)i * b + j;
+                        if (i == j || clique[MODE_PRICE][k] == INT_MAX) continue;
+                        OverlayArc arc;
+                        arc.from = overlayId[ids[i]];
+                        arc.to = overlayId[ids[j]];
+                        for (int mode = MODE_PRICE; mode <= MODE_STOPS; mode++)
+                            arc.weight[mode] = clique[mode][k];
+                        arc.shard = p;
+                        arc.price = arc.time = 0;
+                        all.append(arc);
+                    }
+                }
+            }
+
+            delete[] ids;
+            for (int mode = MODE_PRICE; mode <= MODE_STOPS; mode++)
+                delete[] clique[mode];
+            if (!ok) return false;
+        }
+
+        for (int i = 0; i < cut.size(); i++) {
+            OverlayArc there = cut[i];
+            there.from = overlayId[cut[i].from];
+            there.to = overlayId[cut[i].to];
+            if (there.from < 0 || there.to < 0) return false;
+
+            OverlayArc back = there;
+            back.from = there.to;
+            back.to = there.from;
+            all.append(there);
+            all.append(back);
+        }
+
+        overlayN = vertices.size();
+        overlayVertex = new int[overlayN > 0 ? overlayN : 1];
+        boundaryIndex = new int[overlayN > 0 ? overlayN : 1];
+        for (int o = 0; o < overlayN; o++)
+            overlayVertex[o] = vertices[o];
+        for (int p = 0; p < parts; p++)
+            for (int i = 0; i < boundary[p].size(); i++)
+                boundaryIndex[boundary[p][i]] = i;
+
+        offsets = new int[overlayN + 1];
+        for (int o = 0; o <= overlayN; o++) offsets[o] = 0;
+        for (int i = 0; i < all.size(); i++) offsets[all[i].from + 1]++;
+        for (int o = 0; o < overlayN; o++) offsets[o + 1] += offsets[o];
+
+        int* cursor = new int[overlayN > 0 ? overlayN : 1];
+        for (int o = 0; o < overlayN; o++) cursor[o] = offsets[o];
+        arcs = new OverlayArc[all.size() > 0 ? all.size() : 1];
+        for (int i = 0; i < all.size(); i++)
+            arcs[cursor[all[i].from]++] = all[i];
+        delete[] cursor;
+
+        heap = new MinHeap(overlayN > 0 ? overlayN : 1);
+        dist = new int[overlayN > 0 ? overlayN : 1];
+        predArc = new int[overlayN > 0 ? overlayN : 1];
+        stamp = new int[overlayN > 0 ? overlayN : 1];
+        for (int o = 0; o < overlayN; o++)
+            stamp[o] = 0;
+        return true;
+    }
+
+    int distance(int o) const { return stamp[o] == current ? dist[o] : INT_MAX; }
+
+    static RouteReply failure(int status) {
+        RouteReply reply;
+        reply.header = { 0, status, 0, 0, 0 };
+        return reply;
+    }
+
+public:
+    ShardCoordinator()
+        : n(0), parts(0), part(nullptr), fds(nullptr), pids(nullptr), launched(0),
+          overlayN(0), overlayId(nullptr), overlayVertex(nullptr), boundary(nullptr),
+          boundaryIndex(nullptr), offsets(nullptr), arcs(nullptr), heap(nullptr),
+          dist(nullptr), predArc(nullptr), stamp(nullptr), current(0) {}
+
+    ShardCoordinator(const ShardCoordinator&) = delete;
+    ShardCoordinator& operator=(const ShardCoordinator&) = delete;
+
+    // Closing the sockets ends the workers.
+    ~ShardCoordinator() {
+        for (int p = 0; p < launched; p++) {
+            close(fds[p]);
+            waitpid(pids[p], nullptr, 0);
+        }
+        delete[] fds;
+        delete[] pids;
+        delete[] part;
+        delete[] overlayId;
+        delete[] overlayVertex;
+        delete[] boundary;
+        delete[] boundaryIndex;
+        delete[] offsets;
+        delete[] arcs;
+        delete heap;
+        delete[] dist;
+        delete[] predArc;
+        delete[] stamp;
+    }
+
+    // Reads the overlay file and starts one worker process per shard,
+    // connected by a socketpair. Each worker loads only its own shard
+    // file. False if a file is missing or a worker does not answer.
+    bool launch(const std::string& prefix) {
+        if (!loadOverlay(overlayFile(prefix))) return false;
+
+        fds = new int[parts];
+        pids = new pid_t[parts];
+        for (int p = 0; p < parts; p++) {
+            int pair[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) < 0) return false;
+
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(pair[0]);
+                close(pair[1]);
+                return false;
+            }
+
+            if (pid == 0) {
+                for (int q = 0; q < p; q++) close(fds[q]);
+                close(pair[0]);
+
+                int status = 1;
+                ShardGraph* shard = new ShardGraph();
+                if (shard->load(shardFile(prefix, p))) {
+                    ShardWorker worker(*shard);
+                    worker.serve(pair[1]);
+                    status = 0;
+                }
+                _exit(status);
+            }
+
+            close(pair[1]);
+            fds[p] = pair[0];
+            pids[p] = pid;
+            launched++;
+        }
+        return buildOverlay();
+    }
+
+    int vertexCount() const { return n; }
+
+    int partCount() const { return parts; }
+
+    int overlayVertices() const { return overlayN; }
+
+    int overlayArcs() const { return overlayN > 0 ? offsets[overlayN] : 0; }
+
+    // Best route start -> dest for a RouteMode, as RouteServer would
+    // answer it: ROUTE_OK with the airports and totals, ROUTE_NOT_FOUND
+    // or ROUTE_BAD_QUERY.
+    RouteReply route(int start, int dest, int mode) {
+        if (start < 0 || start >= n || dest < 0 || dest >= n ||
+            mode < MODE_PRICE || mode > MODE_STOPS)
+            return failure(ROUTE_BAD_QUERY);
+
+        if (start == dest) {
+            RouteReply reply = failure(ROUTE_OK);
+            reply.path.append(start);
+            return reply;
+        }
+
+        int ps = part[start], pt = part[dest];
+        int bs = boundary[ps].size(), bt = boundary[pt].size();
+        int* fromStart = new int[bs + 2];
+        int* toDest = new int[bt + 2];
+        bool ok = request(ps, SHARD_FROM, start, dest, mode)
+               && request(pt, SHARD_FROM, dest, start, mode)
+               && readInts(fds[ps], fromStart, bs + 2)
+               && readInts(fds[pt], toDest, bt + 2);
+        if (!ok || fromStart[0] != ROUTE_OK || toDest[0] != ROUTE_OK) {
+            delete[] fromStart;
+            delete[] toDest;
+            return failure(ROUTE_BAD_QUERY);
+        }
+
+        // Overlay Dijkstra from the start's boundary, stopped once
+        // nothing left in the heap can beat the best way to dest.
+        int best = ps == pt ? fromStart[1 + bs] : INT_MAX;
+        int exit = -1;
+        current++;
+        heap->clear();
+        for (int i = 0; i < bs; i++) {
+            int o = boundary[ps][i];
+            if (fromStart[1 + i] == INT_MAX) continue;
+            dist[o] = fromStart[1 + i];
+            predArc[o] = -1;
+            stamp[o] = current;
+            heap->push(o, dist[o]);
+        }
+
+        while (!heap->isEmpty() && heap->minKey() < best) {
+            int u = heap->pop();
+            int du = dist[u];
+            if (part[overlayVertex[u]] == pt) {
+                int tail = toDest[1 + boundaryIndex[u]];
+                if (tail != INT_MAX && du + tail < best) {
+                    best = du + tail;
+                    exit = u;
+                }
+            }
+
+            for (int a = offsets[u]; a < offsets[u + 1]; a++) {
+                int v = arcs[a].to;
+                int dv = du + arcs[a].weight[mode];
+                if (dv < distance(v)) {
+                    dist[v] = dv;
+                    predArc[v] = a;
+                    stamp[v] = current;
+                    heap->push(v, dv);
+                }
+            }
+        }
+        delete[] fromStart;
+        delete[] toDest;
+
+        if (best == INT_MAX) return failure(ROUTE_NOT_FOUND);
+
+        // Pieces in order from start to dest.
+        ArrayList<Segment> reversed;
+        if (exit < 0) {
+            reversed.append({ ps, start, dest, 0, 0 });
+        } else {
+            reversed.append({ pt, overlayVertex[exit], dest, 0, 0 });
+            int o = exit;
+            for (; predArc[o] >= 0; o = arcs[predArc[o]].from) {
+                const OverlayArc& arc = arcs[predArc[o]];
+                reversed.append({ arc.shard, overlayVertex[arc.from],
+                                  overlayVertex[arc.to], arc.price, arc.time });
+            }
+            reversed.append({ ps, start, overlayVertex[o], 0, 0 });
+        }
+
+        // Every piece is read even after a bad one, so each worker's
+        // replies stay in step with its requests.
+        int count = reversed.size();
+        for (int i = count - 1; ok && i >= 0; i--)
+            if (reversed[i].shard >= 0)
+                ok = request(reversed[i].shard, SHARD_PATH, reversed[i].a, reversed[i].b, mode);
+
+        RouteReply reply = failure(ROUTE_OK);
+        bool complete = true;
+        reply.path.append(start);
+        for (int i = count - 1; ok && i >= 0; i--) {
+            const Segment& s = reversed[i];
+            if (s.shard < 0) {
+                reply.path.append(s.b);
+                reply.header.totalPrice += s.price;
+                reply.header.totalTime += s.time;
+                continue;
+            }
+
+            RouteReply piece;
+            ok = readReply(fds[s.shard], piece);
+            if (!ok || piece.header.status != ROUTE_OK) {
+                complete = false;
+                continue;
+            }
+            for (int k = 1; k < piece.path.size(); k++)
+                reply.path.append(piece.path[k]);
+            reply.header.totalPrice += piece.header.totalPrice;
+            reply.header.totalTime += piece.header.totalTime;
+        }
+
+        if (!ok || !complete) return failure(ROUTE_BAD_QUERY);
+        reply.header.count = reply.path.size();
+        return reply;
+    }
+};
+
+#endif
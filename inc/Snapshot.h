@@ -0,0 +1,162 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <ArrayList.h>
+#include <atomic>
+#include <mutex>
+
+//
+// ─── SNAPSHOT ──────────────────────────────────────────────────────────
+//
+// An immutable value plus the number of readers holding it. Version 1
+// is the first value published to a store, 2 the next, and so on.
+//
+template <class T>
+struct Snapshot {
+    T* value;
+    long version;
+    std::atomic<long> refs;
+
+    Snapshot(T* v, long number) : value(v), version(number), refs(0) {}
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    ~Snapshot() {
+        delete value;
+    }
+};
+
+//
+// ─── SNAPSHOT REFERENCE ────────────────────────────────────────────────
+//
+// Counted handle on a Snapshot, like a shared_ptr: the snapshot is not
+// freed while any reference to it exists. Copies are cheap (one atomic
+// add) and may be handed to other threads.
+//
+template <class T>
+class SnapshotRef {
+    Snapshot<T>* snapshot;
+
+    template <class> friend class SnapshotStore;
+
+    explicit SnapshotRef(Snapshot<T>* s) : snapshot(s) {}
+
+    void release() {
+        if (snapshot) snapshot->refs.fetch_sub(1, std::memory_order_release);
+        snapshot = nullptr;
+    }
+
+public:
+    SnapshotRef() : snapshot(nullptr) {}
+
+    SnapshotRef(const SnapshotRef& other) : snapshot(other.snapshot) {
+        if (snapshot) snapshot->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SnapshotRef& operator=(const SnapshotRef& other) {
+        if (other.snapshot) other.snapshot->refs.fetch_add(1, std::memory_order_relaxed);
+        release();
+        snapshot = other.snapshot;
+        return *this;
+    }
+
+    ~SnapshotRef() {
+        release();
+    }
+
+    bool empty() const { return snapshot == nullptr; }
+
+    long version() const { return snapshot ? snapshot->version : 0; }
+
+    T* operator->() const { return snapshot->value; }
+
+    T& operator*() const { return *snapshot->value; }
+};
+
+//
+// ─── SNAPSHOT STORE ────────────────────────────────────────────────────
+//
+// RCU-style publication of immutable values. Readers call acquire() and
+// get whatever is current, with two atomic adds and no lock, never
+// waiting for a writer; publish() swaps in a new value with one atomic
+// exchange. A reader keeps using the snapshot it acquired for as long as
+// it holds the reference, so work in flight finishes on the old version
+// while new work starts on the new one.
+//
+// Readers never free anything. Replaced snapshots are retired and
+// collect() frees those that no reference holds any more, once no
+// reader is between loading the current pointer and counting itself on
+// it: a reader that enters after the swap can only see the new value.
+// publish() collects too; call collect() again later to free snapshots
+// whose readers were still busy. Writers are serialized with a lock.
+//
+template <class T>
+class SnapshotStore {
+    std::atomic<Snapshot<T>*> current;
+    std::atomic<int> entering;      // readers inside acquire()
+    std::mutex writer;
+    ArrayList<Snapshot<T>*> retired;
+    std::atomic<long> published;    // version of `current`
+
+    int collectLocked() {
+        if (entering.load() != 0) return retired.size();
+
+        ArrayList<Snapshot<T>*> kept;
+        for (int i = 0; i < retired.size(); i++) {
+            if (retired[i]->refs.load(std::memory_order_acquire) == 0)
+                delete retired[i];
+            else
+                kept.append(retired[i]);
+        }
+        retired = kept;
+        return retired.size();
+    }
+
+public:
+    SnapshotStore() : current(nullptr), entering(0), published(0) {}
+
+    SnapshotStore(const SnapshotStore&) = delete;
+    SnapshotStore& operator=(const SnapshotStore&) = delete;
+
+    // Every reference must have been dropped by now.
+    ~SnapshotStore() {
+        delete current.load();
+        for (int i = 0; i < retired.size(); i++)
+            delete retired[i];
+    }
+
+    // The current snapshot (empty before the first publish).
+    SnapshotRef<T> acquire() {
+        entering.fetch_add(1);
+        Snapshot<T>* s = current.load();
+        if (s) s->refs.fetch_add(1, std::memory_order_relaxed);
+        entering.fetch_sub(1);
+        return SnapshotRef<T>(s);
+    }
+
+    // Makes `value` current and takes ownership of it. Returns its version.
+    long publish(T* value) {
+        std::lock_guard<std::mutex> guard(writer);
+        long version = published.load() + 1;
+        Snapshot<T>* old = current.exchange(new Snapshot<T>(value, version));
+        published.store(version);
+        if (old) retired.append(old);
+        collectLocked();
+        return version;
+    }
+
+    // Frees retired snapshots nobody holds; returns how many are left.
+    int collect() {
+        std::lock_guard<std::mutex> guard(writer);
+        return collectLocked();
+    }
+
+    // Version of the latest publish, 0 before the first. Never touches
+    // a snapshot, which a concurrent publish could be freeing.
+    long version() const {
+        return published.load();
+    }
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef SORT_H
+#define SORT_H
+
+//
+// ─── MERGE SORT ────────────────────────────────────────────────────────
+//
+// Stable O(n log n) sort for plain arrays, ordered by less(a, b). The
+// engines use it in place of <algorithm>, which the build bans.
+//
+template <class T, class Less>
+void mergeSort(T* items, int n, Less less) {
+    if (n < 2) return;
+
+    T* buffer = new T[n];
+    T* from = items;
+    T* to = buffer;
+
+    for (int width = 1; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                to[k++] = less(from[j], from[i]) ? from[j++] : from[i++];
+            while (i < mid) to[k++] = from[i++];
+            while (j < hi) to[k++] = from[j++];
+        }
+
+        T* swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != items)
+        for (int i = 0; i < n; i++)
+            items[i] = from[i];
+
+    delete[] buffer;
+}
+
+template <class T>
+void mergeSort(T* items, int n) {
+    mergeSort(items, n, [](const T& a, const T& b) { return a < b; });
+}
+
+#endif
@@ -3,8 +3,8 @@
 
 #include <LinkedList.h>
 
-template <class T>
-class Stack : public LinkedList<T> {
+template <class T, class Alloc = NodePool<Link<T>>>
+class Stack : public LinkedList<T, Alloc> {
     void append(T value) {}
     void prepend(T value) {}
     T removeFirst() {}
@@ -12,19 +12,19 @@ class Stack : public LinkedList<T> {
     
 public:
     void push(T value) {
-        LinkedList<T>::prepend(value);
+        LinkedList<T, Alloc>::prepend(value);
     }
 
     T pop() {
-        return LinkedList<T>::removeFirst();
+        return LinkedList<T, Alloc>::removeFirst();
     }
 
     T peek() {
-        return LinkedList<T>::operator[](0);
+        return LinkedList<T, Alloc>::operator[](0);
     }
 
     bool isEmpty() {
-        return LinkedList<T>::size() == 0;
+        return LinkedList<T, Alloc>::size() == 0;
     }
 
     friend struct Graph;
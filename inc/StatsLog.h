@@ -0,0 +1,65 @@
+#ifndef STATS_LOG_H
+#define STATS_LOG_H
+
+#include <Graph.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//
+// ─── SEARCH STATS AS JSON LINES ────────────────────────────────────────
+//
+// One JSON object per query, one query per line, so logs can be appended
+// to forever and loaded with any JSON-lines reader:
+//
+//   {"start":"Chicago","dest":"Rome","mode":"Cheapest Price","found":true,
+//    "nodes_expanded":7,...,"search_ms":0.012,...}
+//
+inline std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            const char* hex = "0123456789abcdef";
+            out += "\\u00";
+            out += hex[(c >> 4) & 0xf];
+            out += hex[c & 0xf];
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+inline std::string statsJson(const std::string& start, const std::string& dest,
+                             const std::string& mode, bool found,
+                             const SearchStats& stats) {
+    std::ostringstream json;
+    json << "{\"start\":" << jsonString(start)
+         << ",\"dest\":" << jsonString(dest)
+         << ",\"mode\":" << jsonString(mode)
+         << ",\"found\":" << (found ? "true" : "false")
+         << ",\"cache_hit\":" << (stats.cacheHit ? "true" : "false")
+         << ",\"nodes_expanded\":" << stats.nodesExpanded
+         << ",\"edges_relaxed\":" << stats.edgesRelaxed
+         << ",\"peak_frontier\":" << stats.peakFrontier
+         << ",\"waypoints_allocated\":" << stats.waypointsAllocated
+         << ",\"hash_probes\":" << stats.hashProbes
+         << ",\"search_ms\":" << stats.searchMs
+         << ",\"extract_ms\":" << stats.extractMs
+         << ",\"render_ms\":" << stats.renderMs
+         << "}";
+    return json.str();
+}
+
+inline bool appendJsonLine(const std::string& filename, const std::string& json) {
+    std::ofstream file(filename, std::ios::app);
+    if (!file.is_open()) return false;
+
+    file << json << '\n';
+    return true;
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <TraceProfiler.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//
+// ─── THREAD POOL ───────────────────────────────────────────────────────
+//
+// Fixed set of workers that all run the same job, fork/join style.
+// The calling thread takes part as worker 0, so a pool of size 1 runs
+// everything inline. Jobs are passed as a (trampoline, context) pair
+// instead of std::function, which would drag in banned STL headers.
+//
+class ThreadPool {
+    std::thread* workers;
+    int count;
+
+    std::mutex lock;
+    std::mutex runLock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    void (*job)(void*, int);
+    void* context;
+    long generation;
+    int pending;
+    bool stopping;
+
+    template <class F>
+    static void trampoline(void* ctx, int worker) {
+        (*static_cast<F*>(ctx))(worker);
+    }
+
+    void workerLoop(int worker) {
+        TraceProfiler::nameThread("pool worker");
+        long seen = 0;
+
+        while (true) {
+            void (*fn)(void*, int);
+            void* ctx;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+
+                seen = generation;
+                fn = job;
+                ctx = context;
+            }
+
+            fn(ctx, worker);
+
+            std::lock_guard<std::mutex> guard(lock);
+            if (--pending == 0)
+                finished.notify_one();
+        }
+    }
+
+public:
+    explicit ThreadPool(int threads = 0)
+        : workers(nullptr), count(threads), job(nullptr), context(nullptr),
+          generation(0), pending(0), stopping(false)
+    {
+        if (count <= 0)
+            count = (int)std::thread::hardware_concurrency();
+        if (count <= 0)
+            count = 1;
+
+        if (count > 1) {
+            workers = new std::thread[count - 1];
+            for (int i = 1; i < count; i++)
+                workers[i - 1] = std::thread(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+
+        for (int i = 0; i < count - 1; i++)
+            workers[i].join();
+        delete[] workers;
+    }
+
+    int size() const { return count; }
+
+    // Runs fn(worker) once on every worker and returns when all are done.
+    template <class F>
+    void run(F& fn) {
+        std::lock_guard<std::mutex> serial(runLock);
+
+        if (count > 1) {
+            std::lock_guard<std::mutex> guard(lock);
+            job = &trampoline<F>;
+            context = &fn;
+            pending = count - 1;
+            generation++;
+        }
+        wake.notify_all();
+
+        fn(0);
+
+        if (count > 1) {
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [&] { return pending == 0; });
+        }
+    }
+
+    // Calls body(i, worker) for every i in [begin, end). Work is handed
+    // out in chunks of `grain` so uneven iterations still balance.
+    template <class F>
+    void parallelFor(int begin, int end, F body, int grain = 64) {
+        if (end <= begin) return;
+
+        if (count == 1 || end - begin <= grain) {
+            for (int i = begin; i < end; i++)
+                body(i, 0);
+            return;
+        }
+
+        std::atomic<int> next(begin);
+        auto chunk = [&](int worker) {
+            while (true) {
+                int lo = next.fetch_add(grain, std::memory_order_relaxed);
+                if (lo >= end) return;
+
+                int hi = lo + grain < end ? lo + grain : end;
+                for (int i = lo; i < hi; i++)
+                    body(i, worker);
+            }
+        };
+        run(chunk);
+    }
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef TIMETABLE_H
+#define TIMETABLE_H
+
+#include <FlatGraph.h>
+#include <GraphGenerator.h>
+#include <GraphLoader.h>
+#include <Sort.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+//
+// ─── TIMETABLE ─────────────────────────────────────────────────────────
+//
+// Scheduled flights instead of static durations. A connection is one
+// flight leg: it leaves `from` at `departure` and lands at `to` at
+// `arrival`, both in minutes from the start of the timetable. Legs that
+// share a trip id are the same aircraft, so staying on board needs no
+// connection time. Stations are Vertex ids.
+//
+struct Connection {
+    int from;
+    int to;
+    int departure;
+    int arrival;
+    int trip;
+};
+
+//
+// All connections in one contiguous array sorted by departure, which is
+// the only order the Connection Scan Algorithm ever reads them in.
+// transferTime is the minimum connection time between two trips.
+//
+struct Timetable {
+    int stations;
+    int trips;
+    int count;
+    int transferTime;
+    Connection* connections;
+
+    Timetable(int stationCount, const ArrayList<Connection>& list, int transfer = 30)
+        : stations(stationCount), trips(0), count(list.size()),
+          transferTime(transfer), connections(new Connection[list.size()])
+    {
+        for (int i = 0; i < count; i++) {
+            connections[i] = list[i];
+            if (connections[i].trip >= trips) trips = connections[i].trip + 1;
+        }
+
+        mergeSort(connections, count, [](const Connection& a, const Connection& b) {
+            return a.departure < b.departure ||
+                   (a.departure == b.departure && a.arrival < b.arrival);
+        });
+    }
+
+    Timetable(const Timetable&) = delete;
+    Timetable& operator=(const Timetable&) = delete;
+
+    ~Timetable() {
+        delete[] connections;
+    }
+
+    // Index of the first connection leaving at or after `time`.
+    int firstDeparting(int time) const {
+        int lo = 0, hi = count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (connections[mid].departure < time) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+};
+
+//
+// ─── TIMETABLE CSV ─────────────────────────────────────────────────────
+//
+// One connection per line: "from,to,departure,arrival[,trip]", with the
+// vertex indices of assets/vertices.csv and times in minutes. Lines
+// without a trip id are flights of their own. Trip ids in the file may
+// be any non-negative numbers; they are renumbered 0, 1, ... in
+// ascending order, so the scratch CSA keeps per trip stays as small as
+// the number of trips. Returns false, with `out`
+// untouched, if the file cannot be read or a line is not a connection
+// between two of the `stations` stations that lands no earlier than it
+// leaves.
+//
+inline bool loadTimetableCSV(ArrayList<Connection>& out, int stations,
+                             const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Cannot open timetable CSV: " << filename << std::endl;
+        return false;
+    }
+
+    ArrayList<Connection> loaded;
+    ArrayList<int> named;       // positions of lines with a trip id
+    ArrayList<int> unnamed;     // and without
+
+    std::string line;
+    long number = 0;
+    while (getline(file, line)) {
+        number++;
+        const char* p = line.c_str();
+        const char* end = p + line.size();
+        while (end > p && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) end--;
+        if (p == end) continue;
+
+        Connection conn;
+        conn.trip = -1;
+        bool ok = parseCSVInt(p, end, conn.from) && skipCSVComma(p, end)
+               && parseCSVInt(p, end, conn.to) && skipCSVComma(p, end)
+               && parseCSVInt(p, end, conn.departure) && skipCSVComma(p, end)
+               && parseCSVInt(p, end, conn.arrival);
+        if (ok && p < end)
+            ok = skipCSVComma(p, end) && parseCSVInt(p, end, conn.trip) && conn.trip >= 0;
+        ok = ok && p == end
+          && conn.from >= 0 && conn.from < stations && conn.to >= 0 && conn.to < stations
+          && conn.departure <= conn.arrival;
+
+        if (!ok) {
+            std::cerr << "ERROR: Bad connection on line " << number << " of "
+                      << filename << std::endl;
+            return false;
+        }
+
+        if (conn.trip < 0) unnamed.append(loaded.size());
+        else named.append(loaded.size());
+        loaded.append(conn);
+    }
+
+    int* byTrip = new int[named.size() > 0 ? named.size() : 1];
+    for (int i = 0; i < named.size(); i++)
+        byTrip[i] = named[i];
+    mergeSort(byTrip, named.size(), [&](int a, int b) {
+        return loaded[a].trip < loaded[b].trip;
+    });
+
+    int trips = 0;
+    for (int i = 0; i < named.size(); i++) {
+        int raw = loaded[byTrip[i]].trip;
+        loaded[byTrip[i]].trip = trips;
+        if (i + 1 == named.size() || loaded[byTrip[i + 1]].trip != raw) trips++;
+    }
+    delete[] byTrip;
+
+    for (int i = 0; i < unnamed.size(); i++)
+        loaded[unnamed[i]].trip = trips++;
+
+    for (int i = 0; i < loaded.size(); i++)
+        out.append(loaded[i]);
+    return true;
+}
+
+//
+// ─── SYNTHETIC TIMETABLE ───────────────────────────────────────────────
+//
+// `perDay` departures a day on every directed route of the graph, over
+// `days` days, at random minutes; each flight takes the route's time.
+// Every flight is its own trip.
+//
+inline void generateTimetable(ArrayList<Connection>& out, const FlatGraph& graph,
+                              int perDay, int days = 1, uint64_t seed = 1) {
+    const int DAY = 24 * 60;
+    Random rng(seed);
+
+    for (int u = 0; u < graph.n; u++) {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+            for (int day = 0; day < days; day++) {
+                for (int k = 0; k < perDay; k++) {
+                    int departure = day * DAY + rng.between(0, DAY - 1);
+                    out.append({ u, graph.targets[e], departure,
+                                 departure + graph.time[e], out.size() });
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+//
+// ─── TRACE EVENTS ──────────────────────────────────────────────────────
+//
+// One finished span. Names are string literals, never copied. Times are
+// nanoseconds since TraceProfiler::start.
+//
+struct TraceEvent {
+    const char* name;
+    long long start;
+    long long duration;
+};
+
+// A thread's ring of events. `written` counts every event ever recorded;
+// the newest EVENTS of them are kept.
+struct TraceBuffer {
+    TraceEvent* events;
+    const char* thread;
+    std::atomic<long> written;
+};
+
+//
+// ─── TRACE PROFILER ────────────────────────────────────────────────────
+//
+// Scoped timers that dump Chrome trace JSON, for chrome://tracing or
+// ui.perfetto.dev. TRACE_SCOPE("name") at the top of a block times the
+// rest of the block; spans on one thread nest the way the blocks do.
+//
+// Nothing is recorded until start(file): a scope is then one relaxed load
+// and a branch. Building with -DFLIGHT_NO_TRACE removes the scopes.
+//
+// Once started, every thread records into a ring buffer of its own,
+// claimed on its first span, with no locking; when the ring is full the
+// oldest spans are overwritten, so memory stays fixed however long the
+// app runs. The trace is written at exit and on SIGUSR1. Dumping uses
+// only open/write/close so it is safe inside the signal handler; a span
+// being recorded at that very moment may come out garbled.
+//
+class TraceProfiler {
+public:
+    static constexpr int MAX_THREADS = 64;
+    static constexpr int EVENTS = 1 << 16;
+
+private:
+    static inline std::atomic<bool> on{false};
+    static inline std::atomic<int> claimed{0};
+    static inline std::atomic_flag dumping = ATOMIC_FLAG_INIT;
+    static inline TraceBuffer buffers[MAX_THREADS];
+    static inline char path[1024];
+    static inline std::chrono::steady_clock::time_point origin;
+
+    static inline thread_local TraceBuffer* mine = nullptr;
+    static inline thread_local bool full = false;
+    static inline thread_local const char* threadName = nullptr;
+
+    // Buffered write(2) with just enough formatting for the trace.
+    struct Writer {
+        int fd;
+        int used;
+        char text[8192];
+
+        explicit Writer(int file) : fd(file), used(0) {}
+
+        void flush() {
+            int done = 0;
+            while (done < used) {
+                long n = ::write(fd, text + done, used - done);
+                if (n <= 0) break;
+                done += (int)n;
+            }
+            used = 0;
+        }
+
+        void put(char c) {
+            if (used == (int)sizeof(text)) flush();
+            text[used++] = c;
+        }
+
+        void put(const char* s) {
+            while (*s) put(*s++);
+        }
+
+        void putString(const char* s) {
+            put('"');
+            for (; *s; s++) {
+                if (*s == '"' || *s == '\\') put('\\');
+                if ((unsigned char)*s >= 0x20) put(*s);
+            }
+            put('"');
+        }
+
+        void putInt(long long x) {
+            char digits[24];
+            int n = 0;
+            if (x < 0) {
+                put('-');
+                x = -x;
+            }
+            do {
+                digits[n++] = (char)('0' + x % 10);
+                x /= 10;
+            } while (x > 0);
+            while (n > 0) put(digits[--n]);
+        }
+
+        // Chrome wants microseconds; keep nanosecond precision.
+        void putMicros(long long ns) {
+            putInt(ns / 1000);
+            put('.');
+            put((char)('0' + ns / 100 % 10));
+            put((char)('0' + ns / 10 % 10));
+            put((char)('0' + ns % 10));
+        }
+    };
+
+    static TraceBuffer* buffer() {
+        if (mine != nullptr || full) return mine;
+
+        int index = claimed.fetch_add(1);
+        if (index >= MAX_THREADS) {
+            full = true;
+            return nullptr;
+        }
+
+        mine = &buffers[index];
+        mine->events = new TraceEvent[EVENTS];
+        mine->thread = threadName;
+        return mine;
+    }
+
+    static void dumpAtExit() {
+        if (enabled()) dump();
+    }
+
+#ifdef SIGUSR1
+    static void onSignal(int) {
+        dump();
+    }
+#endif
+
+public:
+    static bool enabled() { return on.load(std::memory_order_relaxed); }
+
+    static long long now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - origin).count();
+    }
+
+    // Starts recording; the trace goes to `file` at exit or on SIGUSR1.
+    static void start(const char* file) {
+        if (enabled()) return;
+
+        strncpy(path, file, sizeof(path) - 1);
+        origin = std::chrono::steady_clock::now();
+        on.store(true);
+
+        std::atexit(dumpAtExit);
+#ifdef SIGUSR1
+        signal(SIGUSR1, onSignal);
+#endif
+    }
+
+    // start() with the file named by an environment variable, if it is set.
+    static bool startFromEnvironment(const char* variable = "FLIGHT_TRACE") {
+        const char* file = getenv(variable);
+        if (file == nullptr || *file == '\0') return false;
+
+        start(file);
+        return true;
+    }
+
+    // Stops recording. Spans already recorded stay until the next dump().
+    static void stop() {
+        on.store(false);
+    }
+
+    // Label for the calling thread in the trace viewer. Can be called
+    // before start(); it is applied when the thread records its first span.
+    static void nameThread(const char* name) {
+        threadName = name;
+        if (mine != nullptr) mine->thread = name;
+    }
+
+    static void record(const char* name, long long start, long long end) {
+        TraceBuffer* b = buffer();
+        if (b == nullptr) return;
+
+        long i = b->written.load(std::memory_order_relaxed);
+        TraceEvent& e = b->events[i % EVENTS];
+        e.name = name;
+        e.start = start;
+        e.duration = end - start;
+        b->written.store(i + 1, std::memory_order_release);
+    }
+
+    // Spans the calling thread has recorded, including overwritten ones.
+    static long recorded() {
+        return mine != nullptr ? mine->written.load(std::memory_order_relaxed) : 0;
+    }
+
+    // Writes every buffered span to the trace file. Returns false if the
+    // file cannot be opened or another dump is under way.
+    static bool dump() {
+        if (path[0] == '\0' || dumping.test_and_set()) return false;
+
+        int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            dumping.clear();
+            return false;
+        }
+
+        Writer out(fd);
+        long long pid = getpid();
+        bool first = true;
+        out.put("{\"traceEvents\":[\n");
+
+        int threads = claimed.load();
+        if (threads > MAX_THREADS) threads = MAX_THREADS;
+        for (int t = 0; t < threads; t++) {
+            TraceBuffer& b = buffers[t];
+            long written = b.written.load(std::memory_order_acquire);
+            if (written == 0) continue;
+
+            if (!first) out.put(",\n");
+            first = false;
+            out.put("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":");
+            out.putInt(pid);
+            out.put(",\"tid\":");
+            out.putInt(t);
+            out.put(",\"args\":{\"name\":");
+            out.putString(b.thread != nullptr ? b.thread : "thread");
+            out.put("}}");
+
+            for (long i = written > EVENTS ? written - EVENTS : 0; i < written; i++) {
+                const TraceEvent& e = b.events[i % EVENTS];
+                out.put(",\n{\"name\":");
+                out.putString(e.name);
+                out.put(",\"ph\":\"X\",\"pid\":");
+                out.putInt(pid);
+                out.put(",\"tid\":");
+                out.putInt(t);
+                out.put(",\"ts\":");
+                out.putMicros(e.start);
+                out.put(",\"dur\":");
+                out.putMicros(e.duration);
+                out.put('}');
+            }
+        }
+
+        out.put("\n],\"displayTimeUnit\":\"ms\"}\n");
+        out.flush();
+        ::close(fd);
+        dumping.clear();
+        return true;
+    }
+};
+
+//
+// ─── TRACE SCOPE ───────────────────────────────────────────────────────
+//
+class TraceScope {
+    const char* name;
+    long long started;      // -1 while the profiler is off
+
+public:
+    explicit TraceScope(const char* n)
+        : name(n), started(TraceProfiler::enabled() ? TraceProfiler::now() : -1) {}
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope() {
+        if (started >= 0) TraceProfiler::record(name, started, TraceProfiler::now());
+    }
+};
+
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+
+#ifdef FLIGHT_NO_TRACE
+#define TRACE_SCOPE(name)
+#else
+#define TRACE_SCOPE(name) TraceScope TRACE_JOIN(traceScope, __LINE__)(name)
+#endif
+
+#endif
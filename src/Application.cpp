@@ -1,28 +1,75 @@
 #include <Application.h>
 #include <bobcat_ui/bobcat_ui.h>
 
+#include <FL/Fl.H>
 #include <FL/fl_draw.H>
-#include <fstream>
-#include <sstream>
+#include <StatsLog.h>
+#include <TraceProfiler.h>
+#include <cstdlib>
 
 using namespace std;
 using namespace bobcat;
 
+// Vertex index of the airport called `name`, or -1.
+static int findAirport(const Graph& g, const string& name) {
+    for (int i = 0; i < g.vertices.size(); i++)
+        if (g.vertices[i]->data == name) return i;
+    return -1;
+}
+
 //
 // ─────────────────────────────────────────────────────────────
 //  CONSTRUCTOR + DESTRUCTOR
 // ─────────────────────────────────────────────────────────────
 //
 Application::Application() {
+    // FLIGHT_STATS=1 shows search counters under the totals;
+    // FLIGHT_STATS_LOG=<file> appends them as JSON lines.
+    const char* show = getenv("FLIGHT_STATS");
+    const char* log = getenv("FLIGHT_STATS_LOG");
+    showStats = show && string(show) != "0";
+    statsLog = log ? log : "";
+
+    // FLIGHT_QUERY_LOG=<file> appends every answered route query to a
+    // binary log that tools/replay can run against other engines.
+    const char* queries = getenv("FLIGHT_QUERY_LOG");
+    recorder = nullptr;
+    if (queries && *queries) {
+        recorder = new QueryRecorder(queries);
+        if (!recorder->isOpen()) {
+            cerr << "ERROR: Cannot record queries to " << queries << endl;
+            delete recorder;
+            recorder = nullptr;
+        }
+    }
+
+    // FLIGHT_TRACE=<file> records a Chrome trace of startup and every
+    // search, written at exit or on SIGUSR1.
+    TraceProfiler::nameThread("ui");
+    TraceProfiler::startFromEnvironment();
+
+    // Enables Fl::awake, used to hand finished searches back to the UI
+    Fl::lock();
+
     initData();
     initInterface();
 }
 
 Application::~Application() {
+    Fl::remove_timeout(onProgress, this);
+    delete watcher;
+    delete searcher;
+    delete cache;
+    delete recorder;
+
     delete map;
     delete results;
+    delete reach;
+    delete budget;
     delete search;
     delete mode;
+    delete addDest;
+    delete addStart;
     delete dest;
     delete start;
     delete window;
@@ -30,71 +77,28 @@ Application::~Application() {
 
 //
 // ─────────────────────────────────────────────────────────────
-//  LOAD AIRPORTS
+//  INIT DATA
 // ─────────────────────────────────────────────────────────────
 //
-void Application::loadAirports(const std::string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "ERROR: Cannot open vertices CSV: " << filename << endl;
-        return;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        if (line.size() == 0) continue;
-
-        Vertex* v = new Vertex(line);
-        cities.append(v);
-        g.addVertex(v);
-    }
-
-    file.close();
-}
-
+// The first load is published whatever state the files are in; after
+// that the DataWatcher reloads them when they change on disk and only
+// publishes versions that loaded completely (see RELOAD FLIGHT DATA).
 //
-// ─────────────────────────────────────────────────────────────
-//  LOAD EDGES
-// ─────────────────────────────────────────────────────────────
-//
-void Application::loadEdges(const std::string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "ERROR: Cannot open edges CSV: " << filename << endl;
-        return;
-    }
-
-    string line;
-    while (getline(file, line)) {
-        if (line.size() == 0) continue;
-
-        string a, b, c, d;
-        stringstream ss(line);
-
-        getline(ss, a, ',');
-        getline(ss, b, ',');
-        getline(ss, c, ',');
-        getline(ss, d, ',');
+void Application::initData() {
+    TRACE_SCOPE("initData");
+    data.publish(loadFlightData("assets/vertices.csv", "assets/edges.csv", pool));
+    shown = data.acquire();
 
-        int from = stoi(a);
-        int to   = stoi(b);
-        int price = stoi(c);
-        int time  = stoi(d);
+    for (int i = 0; i < shown->g.vertices.size(); i++)
+        cities.append(shown->g.vertices[i]);
 
-        g.addEdge(cities[from], cities[to], price, time);
-    }
+    searcher = new SearchWorker(searchFinished);
+    lastJob = 0;
 
-    file.close();
-}
+    cache = new RouteCache(shown->g, 256);
 
-//
-// ─────────────────────────────────────────────────────────────
-//  INIT DATA
-// ─────────────────────────────────────────────────────────────
-//
-void Application::initData() {
-    loadAirports("assets/vertices.csv");
-    loadEdges("assets/edges.csv");
+    watcher = new DataWatcher(data, "assets/vertices.csv", "assets/edges.csv", pool,
+                              dataReloaded, this);
 }
 
 //
@@ -103,15 +107,24 @@ void Application::initData() {
 // ─────────────────────────────────────────────────────────────
 //
 void Application::initInterface() {
+    TRACE_SCOPE("initInterface");
     window = new Window(100, 100, 900, 550, "Flight Planner");
 
-    // Dropdowns
-    start = new Dropdown(20, 40, 350, 25, "Starting Airport");
-    dest  = new Dropdown(20, 90, 350, 25, "Destination Airport");
+    // Dropdowns, with "+" to accept more than one airport on either end
+    start = new Dropdown(20, 40, 310, 25, "Starting Airport");
+    dest  = new Dropdown(20, 90, 310, 25, "Destination Airport");
+
+    addStart = new Button(335, 40, 35, 25, "+");
+    addDest  = new Button(335, 90, 35, 25, "+");
+    ON_CLICK(addStart, Application::handleAdd);
+    ON_CLICK(addDest, Application::handleAdd);
 
-    for (int i = 0; i < cities.size(); i++) {
-        start->add(cities[i]->data);
-        dest->add(cities[i]->data);
+    {
+        TRACE_SCOPE("populate dropdowns");
+        for (int i = 0; i < cities.size(); i++) {
+            start->add(cities[i]->data);
+            dest->add(cities[i]->data);
+        }
     }
 
     // Search type select
@@ -120,10 +133,22 @@ void Application::initInterface() {
     mode->add("Shortest Time");
     mode->add("Fewest Stops");
 
-    // Search button
-    search = new Button(20, 180, 350, 30, "Search");
+    // Changing the query abandons any search still running for the old one
+    ON_CHANGE(start, Application::handleChange);
+    ON_CHANGE(dest, Application::handleChange);
+    ON_CHANGE(mode, Application::handleChange);
+
+    // Search button, and "everything within <budget>" in the mode's unit
+    search = new Button(20, 180, 170, 30, "Search");
     ON_CLICK(search, Application::handleClick);
 
+    budget = new Fl_Int_Input(200, 180, 70, 30);
+    budget->tooltip("Budget: $ for price, minutes for time, flights for stops");
+    budget->value("500");
+
+    reach = new Button(280, 180, 90, 30, "Reachable");
+    ON_CLICK(reach, Application::handleReach);
+
     // Results panel
     results = new Fl_Scroll(20, 230, 350, 280, "Results");
     results->align(FL_ALIGN_TOP_LEFT);
@@ -131,7 +156,7 @@ void Application::initInterface() {
     results->end();  // critical (do not remove)
 
     // Visualization panel
-    map = new GraphDisplay(400, 20, 480, 500, &g);
+    map = new GraphDisplay(400, 20, 480, 500, &shown->g);
 
     window->show();
 }
@@ -141,107 +166,405 @@ void Application::initInterface() {
 //  HANDLE SEARCH BUTTON CLICK
 // ─────────────────────────────────────────────────────────────
 //
+// Searches run on the SearchWorker thread so the window stays live. A
+// new click replaces whatever search is still running; the answer comes
+// back through Fl::awake to onSearchDone on this thread. Queries that
+// were answered before (in either direction) come straight from the cache.
+//
 void Application::handleClick(bobcat::Widget* sender) {
-    results->clear();
-
+    TRACE_SCOPE("handleClick");
     int sIndex = start->value();
     int dIndex = dest->value();
     int modeIndex = mode->value();
 
-    Vertex* S = cities[sIndex];
-    Vertex* D = cities[dIndex];
+    SearchJob* job = new SearchJob(++lastJob, shown, cities[sIndex], cities[dIndex],
+                                   modeIndex, this);
+    job->alsoStart = alsoStart;
+    job->alsoDest = alsoDest;
+    job->askedUs = QueryRecorder::nowMicros();
+
+    if (!job->isMulti() &&
+        cache->lookup(job->start->id, job->dest->id, modeIndex, job->result)) {
+        searcher->cancel();
+        Fl::remove_timeout(onProgress, this);
+        showResult(job);
+        delete job;
+        return;
+    }
+
+    searcher->submit(job);
+
+    showProgress();
+    Fl::remove_timeout(onProgress, this);
+    Fl::add_timeout(0.1, onProgress, this);
+}
+
+void Application::handleReach(bobcat::Widget* sender) {
+    TRACE_SCOPE("handleReach");
+    int limit = atoi(budget->value());
+    if (limit < 0) limit = 0;
+
+    SearchJob* job = new SearchJob(++lastJob, shown, cities[start->value()], nullptr,
+                                   mode->value(), this);
+    job->budget = limit;
+    searcher->submit(job);
+
+    showProgress();
+    Fl::remove_timeout(onProgress, this);
+    Fl::add_timeout(0.1, onProgress, this);
+}
+
+// "+" next to a dropdown adds its airport to the accepted set for that
+// end of the trip, or takes it out again if it is already there.
+void Application::handleAdd(bobcat::Widget* sender) {
+    bool isStart = sender == addStart;
+    ArrayList<int>& chosen = isStart ? alsoStart : alsoDest;
+    int id = cities[isStart ? start->value() : dest->value()]->id;
+
+    ArrayList<int> kept;
+    for (int i = 0; i < chosen.size(); i++)
+        if (chosen[i] != id) kept.append(chosen[i]);
+
+    if (kept.size() == chosen.size()) kept.append(id);
+    chosen = kept;
+
+    updateChoiceLabels();
+    handleChange(sender);
+}
 
-    SearchResult result;
+void Application::updateChoiceLabels() {
+    const Graph& g = shown->g;
+    string from = "Starting Airport";
+    string to = "Destination Airport";
 
-    if (modeIndex == 0)
-        result = g.ucs(S, D, USE_PRICE);
-    else if (modeIndex == 1)
-        result = g.ucs(S, D, USE_TIME);
-    else
-        result = g.bfs(S, D);
+    for (int i = 0; i < alsoStart.size(); i++)
+        from += (i == 0 ? " (or " : ", ") + g.vertices[alsoStart[i]]->data;
+    if (alsoStart.size() > 0) from += ")";
 
-    Waypoint* goal = result.goal;
-    Waypoint* root = result.root;
+    for (int i = 0; i < alsoDest.size(); i++)
+        to += (i == 0 ? " (or " : ", ") + g.vertices[alsoDest[i]]->data;
+    if (alsoDest.size() > 0) to += ")";
+
+    start->copy_label(from.c_str());
+    dest->copy_label(to.c_str());
+    window->redraw();
+}
+
+void Application::handleChange(bobcat::Widget* sender) {
+    if (!searcher->isBusy()) return;
+
+    lastJob++;  // whatever is in flight is now stale
+    searcher->cancel();
+    Fl::remove_timeout(onProgress, this);
+
+    results->clear();
+    results->add(new TextBox(40, 260, 280, 30, "Search cancelled."));
+    window->redraw();
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  RELOAD FLIGHT DATA
+// ─────────────────────────────────────────────────────────────
+//
+// Runs on the watcher thread once a new version is published: just
+// wake the UI thread, which switches the window over in showData.
+// Searches already running finish on the version they started with
+// (their job holds it) and are still shown.
+void Application::dataReloaded(void* data) {
+    Fl::awake(onDataReloaded, data);
+}
+
+void Application::onDataReloaded(void* data) {
+    static_cast<Application*>(data)->showData();
+}
+
+// Selected and extra airports carry over by name; any the new data no
+// longer has are dropped. The route cache starts over.
+void Application::showData() {
+    TRACE_SCOPE("showData");
+    SnapshotRef<FlightData> next = data.acquire();
+    if (next.version() == shown.version()) return;
+    Graph& g = next->g;
+
+    string from = cities.size() > 0 ? cities[start->value()]->data : "";
+    string to = cities.size() > 0 ? cities[dest->value()]->data : "";
+
+    ArrayList<int>* chosen[] = { &alsoStart, &alsoDest };
+    for (ArrayList<int>* list : chosen) {
+        ArrayList<int> kept;
+        for (int i = 0; i < list->size(); i++) {
+            int v = findAirport(g, shown->g.vertices[(*list)[i]]->data);
+            if (v >= 0) kept.append(v);
+        }
+        *list = kept;
+    }
+
+    cities = ArrayList<Vertex*>();
+    start->clear();
+    dest->clear();
+    for (int i = 0; i < g.vertices.size(); i++) {
+        cities.append(g.vertices[i]);
+        start->add(g.vertices[i]->data);
+        dest->add(g.vertices[i]->data);
+    }
+    int s = findAirport(g, from);
+    int d = findAirport(g, to);
+    start->value(s >= 0 ? s : 0);
+    dest->value(d >= 0 ? d : 0);
+
+    delete cache;
+    cache = new RouteCache(g, 256);
+    map->setGraph(&g);
+
+    // The old version is freed once no search holds it
+    shown = next;
+    updateChoiceLabels();
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  BACKGROUND SEARCH PLUMBING
+// ─────────────────────────────────────────────────────────────
+//
+// Runs on the worker thread: just queue the job for the UI thread.
+void Application::searchFinished(SearchJob* job) {
+    Fl::awake(onSearchDone, job);
+}
+
+void Application::onSearchDone(void* data) {
+    SearchJob* job = static_cast<SearchJob*>(data);
+    Application* app = static_cast<Application*>(job->context);
+
+    // The cache only holds routes of the version on screen
+    if (!job->cancelled() && !job->isBudget() && !job->isMulti() &&
+        job->data.version() == app->shown.version())
+        app->cache->store(job->start->id, job->dest->id, job->modeIndex,
+                          job->result);
+
+    if (!job->cancelled() && job->id == app->lastJob) {
+        Fl::remove_timeout(onProgress, app);
+        if (job->isBudget())
+            app->showReachable(job);
+        else
+            app->showResult(job);
+    }
+    delete job;
+}
+
+void Application::onProgress(void* data) {
+    Application* app = static_cast<Application*>(data);
+    if (!app->searcher->isBusy()) return;
+
+    app->showProgress();
+    Fl::repeat_timeout(0.1, onProgress, data);
+}
+
+void Application::showProgress() {
+    results->clear();
+    results->add(new TextBox(40, 260, 280, 30,
+                             "Searching... " + to_string(searcher->progress())
+                             + " nodes expanded"));
+    window->redraw();
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SHOW SEARCH RESULT
+// ─────────────────────────────────────────────────────────────
+//
+void Application::showResult(SearchJob* job) {
+    TRACE_SCOPE("showResult");
+    results->clear();
+    const Graph& g = job->data->g;
+
+    Vertex* S = job->start;
+    Vertex* D = job->dest;
+    int modeIndex = job->modeIndex;
+    Route& route = job->result;
+    SearchStats& stats = route.stats;
+
+    // With several acceptable airports, show the pair the search picked
+    if (route.found()) {
+        S = g.vertices[route.vertices[0]];
+        D = g.vertices[route.vertices[route.vertices.size() - 1]];
+    }
 
     // No path found
-    if (!goal) {
+    if (!route.found()) {
+        auto rendering = chrono::steady_clock::now();
         results->add(new TextBox(40, 260, 280, 30, "No route found."));
         map->setPath(vector<string>());  // clear map
-        deleteWaypointTree(root);
+        stats.renderMs = millisSince(rendering);
+
+        if (showStats) {
+            int ry = 290;
+            addStats(ry, stats);
+        }
+        logStats(S, D, modeIndex, false, stats);
+        recordQuery(job, false);
+
         window->redraw();
         return;
     }
 
-    // Extract path by walking backwards
-    vector<Waypoint*> rev;
-    Waypoint* temp = goal;
-    while (temp) {
-        rev.push_back(temp);
-        temp = temp->parent;
-    }
-
-    // Reverse order → start → destination
-    for (int i = 0; i < rev.size() / 2; i++) {
-        Waypoint* t = rev[i];
-        rev[i] = rev[rev.size() - 1 - i];
-        rev[rev.size() - 1 - i] = t;
-    }
+    auto rendering = chrono::steady_clock::now();
 
     // Convert to string list for visualization
     vector<string> names;
-    for (int i = 0; i < rev.size(); i++)
-        names.push_back(rev[i]->vertex->data);
+    for (int i = 0; i < route.vertices.size(); i++)
+        names.push_back(g.vertices[route.vertices[i]]->data);
 
     map->setPath(names);
 
     // ---------------- print RESULTS ----------------
     int ry = results->y() + 10;
 
-    int totalPrice = 0;
-    int totalTime  = 0;
-
-    for (int i = 0; i < rev.size() - 1; i++) {
-        Vertex* A = rev[i]->vertex;
-        Vertex* B = rev[i + 1]->vertex;
+    for (int i = 0; i < route.legs.size(); i++) {
+        Edge* e = g.leg(route, i);
 
-        results->add(new TextBox(40, ry, 260, 25, A->data));
+        results->add(new TextBox(40, ry, 260, 25, e->from->data));
         ry += 25;
 
-        for (int j = 0; j < A->edgeList.size(); j++) {
-            Edge* e = A->edgeList[j];
-            if (e->to == B) {
-                totalPrice += e->price;
-                totalTime  += e->time;
+        string info = "Price: $" + to_string(e->price)
+                    + ", Time: " + to_string(e->time) + " min";
 
-                string info = "Price: $" + to_string(e->price)
-                            + ", Time: " + to_string(e->time) + " min";
-
-                results->add(new TextBox(60, ry, 240, 25, info));
-                ry += 25;
-                break;
-            }
-        }
+        results->add(new TextBox(60, ry, 240, 25, info));
+        ry += 25;
     }
 
     // destination display
-    results->add(new TextBox(40, ry, 260, 25,
-                             rev.back()->vertex->data));
+    results->add(new TextBox(40, ry, 260, 25, D->data));
     ry += 30;
 
     // summary
     results->add(new TextBox(40, ry, 260, 25, "=========="));
     ry += 25;
     results->add(new TextBox(40, ry, 260, 25,
-                             "Total Price: $" + to_string(totalPrice)));
+                             "Total Price: $" + to_string(route.totalPrice)));
     ry += 25;
     results->add(new TextBox(40, ry, 260, 25,
-                             "Total Time: " + to_string(totalTime) + " min"));
+                             "Total Time: " + to_string(route.totalTime) + " min"));
     ry += 25;
     results->add(new TextBox(40, ry, 260, 25,
-                             "Stops: " + to_string((int)rev.size() - 2)));
+                             "Stops: " + to_string(route.stops)));
+    ry += 30;
+
+    stats.renderMs = millisSince(rendering);
+
+    if (showStats)
+        addStats(ry, stats);
+    logStats(S, D, modeIndex, true, stats);
+    recordQuery(job, true);
+
+    window->redraw();
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SHOW REACHABLE AIRPORTS
+// ─────────────────────────────────────────────────────────────
+//
+void Application::showReachable(SearchJob* job) {
+    TRACE_SCOPE("showReachable");
+    results->clear();
+    auto rendering = chrono::steady_clock::now();
+
+    static const char* units[] = { "$", " min", " flights" };
+    string unit = units[job->modeIndex];
+    string limit = job->modeIndex == 0 ? unit + to_string(job->budget)
+                                       : to_string(job->budget) + unit;
+
+    // An answer from before a reload is drawn on the new map by name
+    const Graph& g = job->data->g;
+    bool stale = job->data.version() != shown.version();
+    vector<bool> inside(shown->g.vertices.size(), false);
+    for (int i = 0; i < job->reachable.size(); i++) {
+        int v = job->reachable[i].vertex;
+        if (stale) v = findAirport(shown->g, g.vertices[v]->data);
+        if (v >= 0) inside[v] = true;
+    }
+    map->setReachable(inside);
+
+    // The start itself comes first, at cost 0
+    int ry = results->y() + 10;
+    results->add(new TextBox(40, ry, 260, 25,
+                             to_string(job->reachable.size() - 1)
+                             + " airports within " + limit));
+    ry += 30;
+
+    for (int i = 1; i < job->reachable.size(); i++) {
+        const Reachable& r = job->reachable[i];
+        string cost = job->modeIndex == 0 ? unit + to_string(r.cost)
+                                          : to_string(r.cost) + unit;
+
+        results->add(new TextBox(40, ry, 260, 25,
+                                 g.vertices[r.vertex]->data + ": " + cost));
+        ry += 25;
+    }
+    ry += 5;
 
-    // Cleanup whole tree
-    deleteWaypointTree(root);
+    SearchStats& stats = job->result.stats;
+    stats.renderMs = millisSince(rendering);
+    if (showStats)
+        addStats(ry, stats);
 
     window->redraw();
 }
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SEARCH STATISTICS
+// ─────────────────────────────────────────────────────────────
+//
+void Application::addStats(int& ry, const SearchStats& stats) {
+    string lines[] = {
+        "Nodes expanded: " + to_string(stats.nodesExpanded),
+        "Edges relaxed: " + to_string(stats.edgesRelaxed),
+        "Peak frontier: " + to_string(stats.peakFrontier),
+        "Waypoints: " + to_string(stats.waypointsAllocated),
+        "Hash probes: " + to_string(stats.hashProbes),
+        "Search: " + to_string(stats.searchMs) + " ms",
+        "Path: " + to_string(stats.extractMs) + " ms",
+        "Render: " + to_string(stats.renderMs) + " ms",
+        string("Cache: ") + (stats.cacheHit ? "hit" : "miss")
+            + " (" + to_string(cache->hitCount()) + " hits, "
+            + to_string(cache->missCount()) + " misses)"
+    };
+
+    for (const string& line : lines) {
+        results->add(new TextBox(40, ry, 260, 25, line));
+        ry += 25;
+    }
+}
+
+void Application::logStats(Vertex* S, Vertex* D, int modeIndex, bool found,
+                           const SearchStats& stats) {
+    if (statsLog.empty()) return;
+
+    static const char* modes[] = { "Cheapest Price", "Shortest Time", "Fewest Stops" };
+    if (!appendJsonLine(statsLog, statsJson(S->data, D->data, modes[modeIndex],
+                                            found, stats)))
+        cerr << "ERROR: Cannot write stats log: " << statsLog << endl;
+}
+
+// Multi-airport queries are logged with the pair the search picked, and
+// every query with the network that answered it (it may have been
+// reloaded since).
+void Application::recordQuery(SearchJob* job, bool found) {
+    if (!recorder) return;
+
+    const Route& route = job->result;
+    const SearchStats& stats = route.stats;
+    QueryRecord r;
+    r.timestampUs = job->askedUs;
+    r.start = found ? route.vertices[0] : job->start->id;
+    r.dest = found ? route.vertices[route.vertices.size() - 1] : job->dest->id;
+    r.latencyUs = (int)((stats.searchMs + stats.extractMs) * 1000);
+    r.nodesExpanded = (int)stats.nodesExpanded;
+    r.mode = job->modeIndex;
+    r.flags = (found ? QUERY_FOUND : 0) | (stats.cacheHit ? QUERY_CACHE_HIT : 0)
+            | (job->isMulti() ? QUERY_MULTI : 0);
+    r.network = job->data->fingerprint;
+    recorder->record(r);
+}
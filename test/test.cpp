@@ -1,7 +1,1654 @@
 #include <igloo/igloo.h>
 
+#include <BudgetSearch.h>
+#include <CompressedGraph.h>
+#include <ConnectionScan.h>
+#include <CustomizableOverlay.h>
+#include <DeltaStepping.h>
+#include <Dijkstra.h>
+#include <FlightData.h>
+#include <GraphGenerator.h>
+#include <GraphLoader.h>
+#include <HashTable.h>
+#include <HubLabels.h>
+#include <Landmarks.h>
+#include <MemoryBoundedSearch.h>
+#include <MultiSourceBFS.h>
+#include <ParallelBFS.h>
+#include <QueryLog.h>
+#include <Queue.h>
+#include <RouteCache.h>
+#include <SearchTreeCache.h>
+#include <SearchWorker.h>
+#include <ShardedRouting.h>
+#include <Snapshot.h>
+#include <Stack.h>
+#include <TraceProfiler.h>
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
 using namespace igloo;
+using namespace std;
+
+//
+// ─────────────────────────────────────────────────────────────
+//  REFERENCE DIJKSTRA
+// ─────────────────────────────────────────────────────────────
+//
+// Textbook O(n^2) Dijkstra with no heap and no tricks: too slow for real
+// use, simple enough to trust. Every engine is checked against it.
+// Unit weights (hops) when w is null.
+//
+static int* referenceDistances(const FlatGraph& g, int source, const int* w) {
+    int* dist = new int[g.n];
+    bool* done = new bool[g.n];
+    for (int v = 0; v < g.n; v++) {
+        dist[v] = INT_MAX;
+        done[v] = false;
+    }
+    dist[source] = 0;
+
+    while (true) {
+        int u = -1;
+        for (int v = 0; v < g.n; v++)
+            if (!done[v] && dist[v] != INT_MAX && (u < 0 || dist[v] < dist[u]))
+                u = v;
+        if (u < 0) break;
+
+        done[u] = true;
+        for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            int v = g.targets[e];
+            int d = dist[u] + (w ? w[e] : 1);
+            if (d < dist[v]) dist[v] = d;
+        }
+    }
+
+    delete[] done;
+    return dist;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  TEST GRAPHS
+// ─────────────────────────────────────────────────────────────
+//
+// A generated network plus a few airports with no routes at all, so
+// "no route" answers get checked too.
+//
+struct TestNetwork {
+    Graph g;
+    FlatGraph* flat;
+    int* price[3];      // reference distances from the three sources
+    int* time[3];
+    int* hops[3];
+    int sources[3];
+
+    TestNetwork(int vertices, int degree, uint64_t seed) {
+        generateGraph(g, vertices, degree, seed);
+        for (int i = 0; i < 3; i++)
+            g.addVertex(new Vertex("Lonely" + to_string(i)));
+        flat = new FlatGraph(g);
+
+        Random rng(seed * 31 + 7);
+        for (int i = 0; i < 3; i++) {
+            sources[i] = rng.between(0, vertices - 1);
+            price[i] = referenceDistances(*flat, sources[i], flat->price);
+            time[i] = referenceDistances(*flat, sources[i], flat->time);
+            hops[i] = referenceDistances(*flat, sources[i], nullptr);
+        }
+    }
+
+    TestNetwork(const TestNetwork&) = delete;
+    TestNetwork& operator=(const TestNetwork&) = delete;
+
+    ~TestNetwork() {
+        for (int i = 0; i < 3; i++) {
+            delete[] price[i];
+            delete[] time[i];
+            delete[] hops[i];
+        }
+        delete flat;
+    }
+
+    const int* expected(int i, WeightMode mode) const {
+        return mode == USE_PRICE ? price[i] : time[i];
+    }
+};
+
+static const int NETWORKS = 4;
+
+static TestNetwork* network(int k) {
+    return new TestNetwork(120 + 40 * k, 3 + k, 1000 + k);
+}
+
+static int cost(const Route& route, WeightMode mode) {
+    if (!route.found()) return INT_MAX;
+    return mode == USE_PRICE ? route.totalPrice : route.totalTime;
+}
+
+// Route starts and ends in the right places, every leg leaves the vertex
+// before it for the vertex after it, and the totals add up.
+static bool validRoute(Graph& g, const Route& route, int start, int dest) {
+    if (!route.found()) return true;
+
+    int n = route.vertices.size();
+    if (route.vertices[0] != start || route.vertices[n - 1] != dest) return false;
+    if (route.legs.size() != n - 1) return false;
+    if (route.stops != (n > 1 ? n - 2 : 0)) return false;
+
+    int price = 0, time = 0;
+    for (int i = 0; i < n - 1; i++) {
+        Edge* e = g.leg(route, i);
+        if (e->from->id != route.vertices[i] || e->to->id != route.vertices[i + 1])
+            return false;
+        price += e->price;
+        time += e->time;
+    }
+    return price == route.totalPrice && time == route.totalTime;
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  DIFFERENTIAL TESTS
+// ─────────────────────────────────────────────────────────────
+//
+Describe(search_engines_match_reference_dijkstra) {
+    WeightMode modes[2] = { USE_PRICE, USE_TIME };
+
+    It(graph_ucs) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    for (int v = 0; v < t->flat->n; v += 7) {
+                        Route r = t->g.ucs(t->g.vertices[t->sources[i]],
+                                           t->g.vertices[v], mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(graph_bfs) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            for (int i = 0; i < 3; i++) {
+                for (int v = 0; v < t->flat->n; v += 5) {
+                    Route r = t->g.bfs(t->g.vertices[t->sources[i]], t->g.vertices[v]);
+                    int hops = r.found() ? r.legs.size() : INT_MAX;
+                    Assert::That(hops, Equals(t->hops[i][v]));
+                    Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(flat_dijkstra) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            Dijkstra dijkstra(*t->flat);
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    for (int v = 0; v < t->flat->n; v++) {
+                        Route r = dijkstra.route(t->sources[i], v, mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(compressed_dijkstra) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            CompressedGraph compressed(*t->flat);
+            CompressedDijkstra dijkstra(compressed);
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    for (int v = 0; v < t->flat->n; v++) {
+                        Route r = dijkstra.route(t->sources[i], v, mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(compressed_graph_decodes_every_edge) {
+        // Far-apart ids and wide weights, so multi-byte varints, negative
+        // first offsets and 4-byte columns all get used.
+        const int N = 70000;
+        FlatGraph flat(N, 6);
+        for (int v = 0; v <= N; v++) flat.offsets[v] = v < 3 ? 0 : v < 5 ? 3 : 6;
+        int targets[] = { 69999, 5, 1, 0, 40000, 40000 };
+        int prices[] = { 7, 100000, 0, 12, 12, 99 };
+        int times[] = { 300, 1, 2, 3, 4, 5 };
+        for (int e = 0; e < 6; e++) {
+            flat.targets[e] = targets[e];
+            flat.price[e] = prices[e];
+            flat.time[e] = times[e];
+        }
+
+        CompressedGraph compressed(flat);
+        Assert::That(compressed.price.width, Equals(4));
+        Assert::That(compressed.time.width, Equals(2));
+        Assert::That(compressed.slot.width, Equals(1));
+
+        int seen = 0;
+        for (int u = 0; u < N; u++) {
+            int last = -1;
+            compressed.forEachEdge(u, [&](int e, int v) {
+                int original = flat.offsets[u] + compressed.slot.get(e);
+                Assert::That(v, Equals(flat.targets[original]));
+                Assert::That(compressed.price.get(e), Equals(flat.price[original]));
+                Assert::That(compressed.time.get(e), Equals(flat.time[original]));
+                Assert::That(v, IsGreaterThanOrEqualTo(last));
+                last = v;
+                seen++;
+            });
+        }
+        Assert::That(seen, Equals(6));
+    }
+
+    It(delta_stepping) {
+        ThreadPool pool(4);
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            DeltaStepping sssp(*t->flat, pool);
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    ShortestPathTree* tree = sssp.run(t->sources[i], mode);
+                    for (int v = 0; v < t->flat->n; v++)
+                        Assert::That(tree->dist[v], Equals(t->expected(i, mode)[v]));
+                    delete tree;
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(direction_optimizing_bfs_returns_graph_bfs_routes) {
+        ThreadPool pool(4);
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            DirectionOptimizingBFS bfs(*t->flat, pool);
+            for (int i = 0; i < 3; i++) {
+                for (int v = 0; v < t->flat->n; v += 3) {
+                    Route r = bfs.route(t->sources[i], v);
+                    Route expected = t->g.bfs(t->g.vertices[t->sources[i]],
+                                              t->g.vertices[v]);
+                    Assert::That(r.vertices.size(), Equals(expected.vertices.size()));
+                    for (int j = 0; j < r.vertices.size(); j++)
+                        Assert::That(r.vertices[j], Equals(expected.vertices[j]));
+                    for (int j = 0; j < r.legs.size(); j++)
+                        Assert::That(r.legs[j], Equals(expected.legs[j]));
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(search_tree_cache) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            SearchTreeCache trees(*t->flat, 2);
+            Random rng(k);
+            for (int q = 0; q < 300; q++) {
+                int i = rng.between(0, 2);
+                WeightMode mode = modes[rng.between(0, 1)];
+                int v = rng.between(0, t->flat->n - 1);
+
+                Route r = trees.route(t->sources[i], v, mode);
+                Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+            }
+            delete t;
+        }
+    }
+
+    It(alt_search) {
+        ThreadPool pool(2);
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            LandmarkSelection selection = k % 2 ? LANDMARKS_FARTHEST : LANDMARKS_AVOID;
+            Landmarks landmarks(*t->flat, pool, 4, selection);
+            AltSearch alt(*t->flat, landmarks);
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    for (int v = 0; v < t->flat->n; v++) {
+                        Route r = alt.route(t->sources[i], v, mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(ida_star) {
+        ThreadPool pool(2);
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            Landmarks landmarks(*t->flat, pool, 8);
+            IDAStar ida(*t->flat, &landmarks);
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    for (int v = 0; v < t->flat->n; v += 3) {
+                        Route r = ida.route(t->sources[i], v, mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                        Assert::That(r.stats.peakFrontier, IsLessThanOrEqualTo(t->flat->n));
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(sma_star_within_its_node_budget) {
+        ThreadPool pool(2);
+        const int budgets[] = { 48, 4096 };
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            Landmarks landmarks(*t->flat, pool, 8);
+            for (int budget : budgets) {
+                SMAStar sma(*t->flat, budget, &landmarks);
+                for (int i = 0; i < 3; i++) {
+                    for (WeightMode mode : modes) {
+                        for (int v = 0; v < t->flat->n; v += 3) {
+                            Route r = sma.route(t->sources[i], v, mode);
+                            Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                            Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                            Assert::That(r.stats.peakFrontier, IsLessThanOrEqualTo(budget));
+                        }
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(memory_bounded_searches_give_up_on_unreachable_airports_without_landmarks) {
+        Graph g;
+        generateGraph(g, 40, 4);
+        g.addVertex(new Vertex("Island"));
+        FlatGraph flat(g);
+        IDAStar ida(flat);
+        SMAStar sma(flat, 64);
+
+        for (WeightMode mode : modes) {
+            Route r = ida.route(0, 40, mode);
+            Assert::That(r.found(), IsFalse());
+            Assert::That(r.stats.nodesExpanded, Equals(0L));
+
+            r = sma.route(40, 0, mode);
+            Assert::That(r.found(), IsFalse());
+            Assert::That(r.stats.nodesExpanded, Equals(0L));
+
+            Assert::That(ida.route(0, 39, mode).found(), IsTrue());
+            Assert::That(sma.route(0, 39, mode).found(), IsTrue());
+        }
+    }
+
+    It(hub_labels_after_save_and_load) {
+        const string file = "/tmp/flight-planner-test.hlb";
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            HubLabels built(*t->flat);
+            HubLabels labels;
+            Assert::That(built.save(file), IsTrue());
+            Assert::That(labels.load(file), IsTrue());
+
+            for (int i = 0; i < 3; i++) {
+                for (WeightMode mode : modes) {
+                    for (int v = 0; v < t->flat->n; v++) {
+                        Assert::That(labels.distance(t->sources[i], v, mode),
+                                     Equals(t->expected(i, mode)[v]));
+
+                        Route r = labels.route(*t->flat, t->sources[i], v, mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+        remove(file.c_str());
+    }
+
+    It(hub_labels_reject_corrupt_files) {
+        const string file = "/tmp/flight-planner-corrupt.hlb";
+        TestNetwork* t = network(0);
+        int n = t->flat->n;
+        HubLabels built(*t->flat);
+        Assert::That(built.save(file), IsTrue());
+
+        ifstream in(file, ios::binary);
+        string good((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        in.close();
+
+        // Byte offsets of order[0], then price's first[1] and hub[0]
+        long order = 8, first = 8 + 4L * n + 8 + 8, hub = first + 8L * n;
+        long badFirst = -5;
+        int badRank = n;
+
+        string cut = good.substr(0, good.size() - 10);
+        string descending = good;
+        memcpy(&descending[first], &badFirst, 8);
+        string badHub = good;
+        memcpy(&badHub[hub], &badRank, 4);
+        string badOrder = good;
+        memcpy(&badOrder[order], &badRank, 4);
+        string repeatedRank = good;
+        memcpy(&repeatedRank[order + 4], &good[order], 4);
+
+        for (const string& bytes : { cut, descending, badHub, badOrder, repeatedRank }) {
+            ofstream out(file, ios::binary);
+            out << bytes;
+            out.close();
+
+            HubLabels labels;
+            Assert::That(labels.load(file), IsFalse());
+            Assert::That(labels.vertexCount(), Equals(0));
+        }
+
+        // A `next` pointer back to its own vertex loads (every field is
+        // in range) but must not send route() round in circles.
+        long size, offsets[2], start = first - 8;
+        memcpy(&size, &good[start - 8], 8);
+        int v = 0;
+        for (;; v++) {
+            memcpy(offsets, &good[start + 8L * v], 16);
+            if (offsets[1] - offsets[0] >= 2) break;
+        }
+        long nexts = start + 8L * (n + 1) + 8 * size;
+        string cycle = good;
+        for (long k = offsets[0]; k < offsets[1]; k++)
+            memcpy(&cycle[nexts + 4 * k], &v, 4);
+        ofstream out(file, ios::binary);
+        out << cycle;
+        out.close();
+
+        HubLabels labels;
+        Assert::That(labels.load(file), IsTrue());
+        int lost = 0;
+        for (int u = 0; u < n; u++) {
+            Route r = labels.route(*t->flat, v, u, USE_PRICE);
+            if (r.found())
+                Assert::That(validRoute(t->g, r, v, u), IsTrue());
+            else
+                lost++;
+        }
+        Assert::That(lost, IsGreaterThan(0));
+        delete t;
+        remove(file.c_str());
+    }
+
+    It(budget_search) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            BudgetSearch search(*t->flat);
+            ArrayList<Reachable> found;
+            BudgetUnit units[] = { BUDGET_PRICE, BUDGET_TIME, BUDGET_STOPS };
+
+            for (int i = 0; i < 3; i++) {
+                for (BudgetUnit unit : units) {
+                    const int* expected = unit == BUDGET_PRICE ? t->price[i]
+                                        : unit == BUDGET_TIME ? t->time[i] : t->hops[i];
+                    int budget = unit == BUDGET_STOPS ? 2 : 700;
+                    search.run(t->sources[i], unit, budget, found);
+
+                    int inside = 0;
+                    for (int v = 0; v < t->flat->n; v++)
+                        if (expected[v] <= budget) inside++;
+                    Assert::That(found.size(), Equals(inside));
+                    for (int j = 0; j < found.size(); j++)
+                        Assert::That(found[j].cost, Equals(expected[found[j].vertex]));
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(set_to_set_routes) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            Dijkstra dijkstra(*t->flat);
+            Random rng(k + 50);
+            for (int q = 0; q < 40; q++) {
+                ArrayList<int> sources, targets;
+                for (int i = 0; i < 3; i++) sources.append(t->sources[i]);
+                for (int j = 0; j < 4; j++) targets.append(rng.between(0, t->flat->n - 1));
+
+                for (WeightMode mode : modes) {
+                    int best = INT_MAX;
+                    for (int i = 0; i < 3; i++)
+                        for (int j = 0; j < 4; j++)
+                            if (t->expected(i, mode)[targets[j]] < best)
+                                best = t->expected(i, mode)[targets[j]];
+
+                    Route r = dijkstra.route(sources, targets, mode);
+                    Assert::That(cost(r, mode), Equals(best));
+                    if (r.found()) {
+                        Assert::That(validRoute(t->g, r, r.vertices[0],
+                                                r.vertices[r.vertices.size() - 1]),
+                                     IsTrue());
+                        Assert::That(sources.search(r.vertices[0]), IsTrue());
+                        Assert::That(targets.search(r.vertices[r.vertices.size() - 1]),
+                                     IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(route_cache_answers_reversed_pairs) {
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            Dijkstra dijkstra(*t->flat);
+            RouteCache cache(t->g, 16);
+            for (int i = 0; i < 3; i++) {
+                for (int v = 0; v < t->flat->n; v += 11) {
+                    int s = t->sources[i];
+                    cache.store(s, v, 0, dijkstra.route(s, v, USE_PRICE));
+
+                    Route back;
+                    Assert::That(cache.lookup(v, s, 0, back), IsTrue());
+                    Assert::That(back.stats.cacheHit, IsTrue());
+                    Assert::That(cost(back, USE_PRICE), Equals(t->price[i][v]));
+                    Assert::That(validRoute(t->g, back, v, s), IsTrue());
+                }
+            }
+
+            Route stale;
+            t->g.addEdge(t->g.vertices[0], t->g.vertices[1], 1, 1);
+            Assert::That(cache.lookup(t->sources[0], 0, 0, stale), IsFalse());
+            Assert::That(cache.size(), Equals(0));
+            delete t;
+        }
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  NODE POOL
+// ─────────────────────────────────────────────────────────────
+//
+// Once a list has been as long as it gets, pushing and popping must not
+// reach the heap again: every link comes back off the free list.
+//
+Describe(linked_lists_recycle_their_links) {
+    It(stack_push_pop_in_steady_state) {
+        Stack<int> stack;
+        for (int i = 0; i < 100; i++) stack.push(i);
+        while (!stack.isEmpty()) stack.pop();
+        long warm = stack.allocationStats().heapAllocations;
+
+        long sum = 0;
+        for (int round = 0; round < 50; round++) {
+            for (int i = 0; i < 100; i++) stack.push(i);
+            while (!stack.isEmpty()) sum += stack.pop();
+        }
+
+        Assert::That(sum, Equals(50L * 4950));
+        Assert::That(stack.allocationStats().heapAllocations, Equals(warm));
+        Assert::That(stack.allocationStats().recycled, Equals(50L * 100));
+        Assert::That(stack.allocationStats().live, Equals(0L));
+    }
+
+    It(queue_enqueue_dequeue_in_steady_state) {
+        Queue<int> queue;
+        for (int i = 0; i < 64; i++) queue.enqueue(i);
+        long warm = queue.allocationStats().heapAllocations;
+
+        for (int i = 0; i < 10000; i++) {
+            Assert::That(queue.dequeue(), Equals(i));
+            queue.enqueue(i + 64);
+        }
+
+        Assert::That(queue.size(), Equals(64));
+        Assert::That(queue.allocationStats().heapAllocations, Equals(warm));
+    }
+
+    It(heap_nodes_allocate_every_link) {
+        Queue<int, HeapNodes<Link<int>>> queue;
+        for (int round = 0; round < 10; round++) {
+            for (int i = 0; i < 10; i++) queue.enqueue(i);
+            while (!queue.isEmpty()) queue.dequeue();
+        }
+
+        Assert::That(queue.allocationStats().heapAllocations, Equals(100L));
+        Assert::That(queue.allocationStats().heapFrees, Equals(100L));
+    }
+
+    It(copies_get_their_own_pool) {
+        LinkedList<string> list;
+        list.append("b");
+        list.append("c");
+        list.prepend("a");
+
+        LinkedList<string> copy(list);
+        list.removeFirst();
+        copy.append("d");
+
+        Assert::That(list.size(), Equals(2));
+        Assert::That(copy.size(), Equals(4));
+        Assert::That(copy[0], Equals("a"));
+        Assert::That(copy[3], Equals("d"));
+        Assert::That(list.allocationStats().live, Equals(2L));
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  PARALLEL EDGE LOADER
+// ─────────────────────────────────────────────────────────────
+//
+// Loading in chunks must leave exactly what addEdge per line leaves:
+// same rows in the same order, same twins, and a FlatGraph to match.
+//
+static void addAirports(Graph& g, int n) {
+    for (int v = 0; v < n; v++)
+        g.addVertex(new Vertex("A" + to_string(v)));
+}
+
+static void sameAsSequential(const string& file, int n, int threads) {
+    Graph expected, loaded;
+    addAirports(expected, n);
+    addAirports(loaded, n);
+    Assert::That(loadEdgesCSV(expected, file), IsTrue());
+
+    ThreadPool pool(threads);
+    EdgeLoadStats stats;
+    FlatGraph* flat = loadEdgesCSVParallel(loaded, file, pool, &stats);
+    Assert::That(flat != nullptr, IsTrue());
+    Assert::That(stats.edges, Equals(expected.version));
+    Assert::That(loaded.version, Equals(expected.version));
+
+    FlatGraph reference(expected);
+    Assert::That(flat->m, Equals(reference.m));
+    for (int v = 0; v < n; v++) {
+        const ArrayList<Edge*>& a = expected.vertices[v]->edgeList;
+        const ArrayList<Edge*>& b = loaded.vertices[v]->edgeList;
+        Assert::That(b.size(), Equals(a.size()));
+        Assert::That(flat->offsets[v], Equals(reference.offsets[v]));
+        for (int j = 0; j < a.size(); j++) {
+            Assert::That(b[j]->from->id, Equals(v));
+            Assert::That(b[j]->to->id, Equals(a[j]->to->id));
+            Assert::That(b[j]->price, Equals(a[j]->price));
+            Assert::That(b[j]->time, Equals(a[j]->time));
+            Assert::That(b[j]->twin, Equals(a[j]->twin));
+
+            int e = flat->offsets[v] + j;
+            Assert::That(flat->targets[e], Equals(reference.targets[e]));
+            Assert::That(flat->price[e], Equals(reference.price[e]));
+            Assert::That(flat->time[e], Equals(reference.time[e]));
+        }
+    }
+    delete flat;
+}
+
+Describe(parallel_edge_loader) {
+    It(matches_the_shipped_edges) {
+        Graph g;
+        Assert::That(loadAirportsCSV(g, "assets/vertices.csv"), IsTrue());
+        sameAsSequential("assets/edges.csv", g.vertices.size(), 4);
+    }
+
+    It(matches_across_many_chunks) {
+        // Enough lines for several 64 KB chunks, with parallel edges,
+        // self-loops, blank lines and CRLF endings thrown in.
+        const int n = 3000;
+        string file = "/tmp/parallel_loader_test.csv";
+        ofstream out(file);
+        Random rng(31);
+        for (int i = 0; i < 60000; i++) {
+            int a = rng.between(0, n - 1);
+            int b = i % 97 == 0 ? a : rng.between(0, n - 1);
+            out << a << "," << b << "," << rng.between(1, 900) << ","
+                << rng.between(20, 600) << (i % 5 == 0 ? "\r\n" : "\n");
+            if (i % 1000 == 0) out << "\n";
+        }
+        out.close();
+
+        sameAsSequential(file, n, 1);
+        sameAsSequential(file, n, 4);
+        sameAsSequential(file, n, 7);
+        remove(file.c_str());
+    }
+
+    It(rejects_bad_lines_without_touching_the_graph) {
+        string file = "/tmp/parallel_loader_bad.csv";
+        ofstream out(file);
+        out << "0,1,10,20\n1,2,10,20\n2,x,10,20\n";
+        out.close();
+
+        Graph g;
+        addAirports(g, 3);
+        ThreadPool pool(2);
+        Assert::That(loadEdgesCSVParallel(g, file, pool) == nullptr, IsTrue());
+        Assert::That(g.vertices[0]->edgeList.size(), Equals(0));
+        Assert::That(g.version, Equals(0L));
+
+        ofstream range(file);
+        range << "0,1,10,20\n0,3,10,20\n";
+        range.close();
+        Assert::That(loadEdgesCSVParallel(g, file, pool) == nullptr, IsTrue());
+        remove(file.c_str());
+    }
+
+    It(rejects_a_path_that_is_not_a_file) {
+        Graph g;
+        addAirports(g, 3);
+        ThreadPool pool(2);
+        Assert::That(loadEdgesCSVParallel(g, "/tmp", pool) == nullptr, IsTrue());
+        Assert::That(g.version, Equals(0L));
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  PARTITIONING AND SHARDED ROUTING
+// ─────────────────────────────────────────────────────────────
+//
+// Shards run as real worker processes. Every answer the coordinator
+// puts together from shard distances and the overlay must cost what a
+// search over the whole network costs, and be a real path.
+//
+static bool adjacent(const FlatGraph& g, int u, int v) {
+    for (int e = g.offsets[u]; e < g.offsets[u + 1]; e++)
+        if (g.targets[e] == v) return true;
+    return false;
+}
+
+static void checkSharded(TestNetwork* t, int parts) {
+    string prefix = "/tmp/sharded_routing_test";
+    RecursiveBisection bisection(*t->flat);
+    Partition* partition = bisection.run(parts);
+    Assert::That(writeShards(*t->flat, *partition, prefix), IsTrue());
+    delete partition;
+
+    ShardCoordinator coordinator;
+    Assert::That(coordinator.launch(prefix), IsTrue());
+    Assert::That(coordinator.vertexCount(), Equals(t->flat->n));
+
+    for (int i = 0; i < 3; i++) {
+        int s = t->sources[i];
+        for (int v = 0; v < t->flat->n; v++) {
+            for (int mode = MODE_PRICE; mode <= MODE_STOPS; mode++) {
+                const int* expected = mode == MODE_PRICE ? t->price[i]
+                                    : mode == MODE_TIME ? t->time[i] : t->hops[i];
+                RouteReply r = coordinator.route(s, v, mode);
+                if (expected[v] == INT_MAX) {
+                    Assert::That(r.header.status, Equals((int)ROUTE_NOT_FOUND));
+                    continue;
+                }
+
+                Assert::That(r.header.status, Equals((int)ROUTE_OK));
+                int n = r.path.size();
+                int got = mode == MODE_PRICE ? r.header.totalPrice
+                        : mode == MODE_TIME ? r.header.totalTime : n - 1;
+                Assert::That(got, Equals(expected[v]));
+                Assert::That(r.path[0], Equals(s));
+                Assert::That(r.path[n - 1], Equals(v));
+                for (int k = 0; k + 1 < n; k++)
+                    Assert::That(adjacent(*t->flat, r.path[k], r.path[k + 1]), IsTrue());
+            }
+        }
+    }
+
+    Assert::That(coordinator.route(-1, 0, MODE_PRICE).header.status,
+                 Equals((int)ROUTE_BAD_QUERY));
+    for (int p = 0; p < parts; p++)
+        remove(shardFile(prefix, p).c_str());
+    remove(overlayFile(prefix).c_str());
+}
+
+Describe(sharded_routing) {
+    It(recursive_bisection_finds_regions) {
+        Graph g;
+        generateRegionalGraph(g, 2000, 8, 8, 5);
+        FlatGraph flat(g);
+
+        RecursiveBisection bisection(flat);
+        Partition* partition = bisection.run(4);
+        int total = 0;
+        for (int p = 0; p < 4; p++) {
+            Assert::That(partition->size(p), IsGreaterThanOrEqualTo(450));
+            Assert::That(partition->size(p), IsLessThanOrEqualTo(550));
+            total += partition->size(p);
+        }
+        Assert::That(total, Equals(2000));
+        Assert::That(partition->cutEdges, Equals(partition->countCut(flat)));
+        Assert::That(partition->cutEdges * 10, IsLessThan((long)flat.m / 2));
+        delete partition;
+    }
+
+    It(matches_whole_graph_dijkstra) {
+        for (int k = 0; k < 2; k++) {
+            TestNetwork* t = network(k);
+            checkSharded(t, 3);
+            checkSharded(t, 4);
+            delete t;
+        }
+    }
+
+    It(works_with_a_single_shard) {
+        TestNetwork* t = network(2);
+        checkSharded(t, 1);
+        delete t;
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  BIT-PARALLEL MULTI-SOURCE BFS
+// ─────────────────────────────────────────────────────────────
+//
+// Every row of a hop matrix must equal a single-source BFS from that
+// row's airport, whichever batch and lane the source landed in.
+//
+static void checkRows(const FlatGraph& g, const HopMatrix& m, const int* sources,
+                      const int* targets) {
+    for (int i = 0; i < m.rows; i++) {
+        int* expected = referenceDistances(g, sources[i], nullptr);
+        for (int j = 0; j < m.cols; j++)
+            Assert::That(m.at(i, j), Equals(expected[targets[j]]));
+        delete[] expected;
+    }
+}
+
+Describe(multi_source_bfs) {
+    It(all_pairs_match_single_source_bfs) {
+        ThreadPool pool(2);
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            HopMatrix* m = allPairsHops(*t->flat, pool);
+
+            int* all = new int[t->flat->n];
+            for (int v = 0; v < t->flat->n; v++) all[v] = v;
+            checkRows(*t->flat, *m, all, all);
+
+            delete[] all;
+            delete m;
+            delete t;
+        }
+    }
+
+    It(spans_several_batches) {
+        Graph g;
+        generateGraph(g, 700, 3, 17);
+        FlatGraph flat(g);
+        ThreadPool pool(3);
+
+        HopMatrix* m = allPairsHops(flat, pool);
+        int* all = new int[flat.n];
+        for (int v = 0; v < flat.n; v++) all[v] = v;
+        checkRows(flat, *m, all, all);
+
+        delete[] all;
+        delete m;
+    }
+
+    It(handles_repeated_sources_and_few_targets) {
+        TestNetwork* t = network(1);
+        int n = t->flat->n;
+        Random rng(5);
+
+        const int ROWS = 300;
+        int sources[ROWS];
+        for (int i = 0; i < ROWS; i++)
+            sources[i] = i % 7 == 0 ? t->sources[0] : rng.between(0, n - 1);
+        int targets[] = { t->sources[1], n - 1, 0, t->sources[2] };
+
+        ThreadPool pool(1);
+        HopMatrix* m = hopMatrix(*t->flat, sources, ROWS, targets, 4, pool);
+        checkRows(*t->flat, *m, sources, targets);
+        Assert::That(m->at(0, 1), Equals(INT_MAX));     // n - 1 is a lonely airport
+
+        delete m;
+        delete t;
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  CUSTOMIZABLE OVERLAY
+// ─────────────────────────────────────────────────────────────
+//
+// Overlay queries must cost what plain Dijkstra costs, before and after
+// the weights change underneath a partition that stays the same.
+//
+Describe(customizable_overlay) {
+    WeightMode modes[2] = { USE_PRICE, USE_TIME };
+
+    It(matches_reference_dijkstra) {
+        ThreadPool pool(2);
+        for (int k = 0; k < NETWORKS; k++) {
+            TestNetwork* t = network(k);
+            CustomizableOverlay overlay(*t->flat);
+            overlay.customize(pool);
+            OverlayQuery query(overlay);
+
+            for (WeightMode mode : modes) {
+                for (int i = 0; i < 3; i++) {
+                    for (int v = 0; v < t->flat->n; v++) {
+                        Route r = query.route(t->sources[i], v, mode);
+                        Assert::That(cost(r, mode), Equals(t->expected(i, mode)[v]));
+                        Assert::That(validRoute(t->g, r, t->sources[i], v), IsTrue());
+                    }
+                }
+            }
+            delete t;
+        }
+    }
+
+    It(follows_new_prices_after_customizing) {
+        ThreadPool pool(3);
+        Graph g;
+        generateRegionalGraph(g, 1500, 6, 6, 3);
+        FlatGraph flat(g);
+        CustomizableOverlay overlay(flat, 3);
+        Assert::That(overlay.levelsUsed(), Equals(3));
+        overlay.customize(pool);
+        OverlayQuery query(overlay);
+
+        Random rng(12);
+        for (int round = 0; round < 3; round++) {
+            for (int e = 0; e < flat.m; e++)
+                flat.price[e] = rng.between(1, 1000);
+            overlay.customize(USE_PRICE, pool);
+
+            for (int i = 0; i < 4; i++) {
+                int s = rng.between(0, flat.n - 1);
+                int* expected = referenceDistances(flat, s, flat.price);
+                for (int v = 0; v < flat.n; v += 7) {
+                    Route r = query.route(s, v, USE_PRICE);
+                    Assert::That(cost(r, USE_PRICE), Equals(expected[v]));
+                    Assert::That(r.vertices[0], Equals(s));
+                    Assert::That(r.vertices[r.vertices.size() - 1], Equals(v));
+                }
+                delete[] expected;
+            }
+        }
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  CONNECTION SCAN
+// ─────────────────────────────────────────────────────────────
+//
+// Earliest arrival by relaxing every connection until nothing improves,
+// in no particular order. Only for timetables where each flight is its
+// own trip, so every change of flight needs the transfer time.
+static int bruteForceArrival(const Timetable& table, int source, int target,
+                             int departure) {
+    int* arrival = new int[table.stations];
+    for (int s = 0; s < table.stations; s++) arrival[s] = INT_MAX;
+    arrival[source] = departure;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = table.count - 1; i >= 0; i--) {
+            const Connection& c = table.connections[i];
+            if (arrival[c.from] == INT_MAX) continue;
+
+            int ready = c.from == source ? arrival[c.from]
+                                         : arrival[c.from] + table.transferTime;
+            if (ready <= c.departure && c.arrival < arrival[c.to]) {
+                arrival[c.to] = c.arrival;
+                changed = true;
+            }
+        }
+    }
+
+    int best = arrival[target];
+    delete[] arrival;
+    return best;
+}
+
+Describe(connection_scan) {
+    It(matches_brute_force_earliest_arrival) {
+        Graph g;
+        generateGraph(g, 150, 5);
+        FlatGraph flat(g);
+        ArrayList<Connection> list;
+        generateTimetable(list, flat, 3, 2);
+        Timetable table(flat.n, list);
+
+        ConnectionScan csa(table);
+        Random rng(17);
+        int reached = 0;
+        for (int q = 0; q < 60; q++) {
+            int s = rng.between(0, flat.n - 1);
+            int t = rng.between(0, flat.n - 1);
+            int departure = rng.between(0, 24 * 60 - 1);
+
+            Journey j = csa.earliestArrival(s, t, departure);
+            Assert::That(j.arrival, Equals(bruteForceArrival(table, s, t, departure)));
+            if (j.found()) reached++;
+        }
+        Assert::That(reached, IsGreaterThan(30));
+    }
+
+    It(loads_trips_and_rejects_bad_lines) {
+        string file = "/tmp/timetable_test.csv";
+        ofstream out(file);
+        out << "0,1,60,120,2147483647\r\n1,2,130,200,2147483647\n\n2,0,300,360\n"
+            << "0,2,400,500,2000000000\n";
+        out.close();
+
+        // Trip ids come back dense, in ascending order of the file's ids
+        ArrayList<Connection> list;
+        Assert::That(loadTimetableCSV(list, 3, file), IsTrue());
+        Assert::That(list.size(), Equals(4));
+        Assert::That(list[0].trip, Equals(1));
+        Assert::That(list[1].trip, Equals(1));
+        Assert::That(list[2].trip, Equals(2));
+        Assert::That(list[3].trip, Equals(0));
+
+        Timetable table(3, list);
+        Assert::That(table.trips, Equals(3));
+        ConnectionScan csa(table);
+        Assert::That(csa.earliestArrival(0, 2, 0).arrival, Equals(200));
+        Assert::That(csa.earliestArrival(0, 2, 100).arrival, Equals(500));
+
+        const char* bad[] = {
+            "0,3,60,120\n",        // no such station
+            "-1,1,60,120\n",
+            "0,1,120,60\n",        // lands before it leaves
+            "0,1,60\n",
+            "0,1,60,120,x\n",
+        };
+        for (const char* line : bad) {
+            ofstream broken(file);
+            broken << "0,1,60,120\n" << line;
+            broken.close();
+
+            ArrayList<Connection> rejected;
+            Assert::That(loadTimetableCSV(rejected, 3, file), IsFalse());
+            Assert::That(rejected.size(), Equals(0));
+        }
+        remove(file.c_str());
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  TRACE PROFILER
+// ─────────────────────────────────────────────────────────────
+//
+static string readFile(const string& file) {
+    ifstream in(file);
+    stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+static int occurrences(const string& text, const string& word) {
+    int count = 0;
+    for (size_t at = text.find(word); at != string::npos; at = text.find(word, at + 1))
+        count++;
+    return count;
+}
+
+static void nestedSpans() {
+    TRACE_SCOPE("outer");
+    for (int i = 0; i < 3; i++) {
+        TRACE_SCOPE("inner");
+    }
+}
+
+Describe(trace_profiler) {
+    It(records_nested_spans_per_thread_once_started) {
+        string file = "/tmp/trace_profiler_test.json";
+        nestedSpans();
+        Assert::That(TraceProfiler::recorded(), Equals(0L));
+
+        TraceProfiler::start(file.c_str());
+        nestedSpans();
+        std::thread other([] {
+            TraceProfiler::nameThread("other");
+            nestedSpans();
+        });
+        other.join();
+        Assert::That(TraceProfiler::recorded(), Equals(4L));
+
+        Assert::That(TraceProfiler::dump(), IsTrue());
+        TraceProfiler::stop();
+
+        string trace = readFile(file);
+        Assert::That(trace.find("{\"traceEvents\":["), Equals((size_t)0));
+        Assert::That(occurrences(trace, "\"name\":\"outer\""), Equals(2));
+        Assert::That(occurrences(trace, "\"name\":\"inner\""), Equals(6));
+        Assert::That(occurrences(trace, "\"args\":{\"name\":\"other\"}"), Equals(1));
+        Assert::That(trace.find("\"displayTimeUnit\":\"ms\"}") != string::npos, IsTrue());
+        remove(file.c_str());
+    }
+
+    It(keeps_the_newest_spans_when_a_ring_fills) {
+        string file = "/tmp/trace_profiler_ring.json";
+        TraceProfiler::start(file.c_str());
+        long recorded = 0;
+        std::thread busy([&recorded] {
+            for (int i = 0; i < TraceProfiler::EVENTS + 100; i++) {
+                TRACE_SCOPE("ring");
+            }
+            recorded = TraceProfiler::recorded();
+        });
+        busy.join();
+        Assert::That(recorded, Equals((long)TraceProfiler::EVENTS + 100));
+
+        Assert::That(TraceProfiler::dump(), IsTrue());
+        TraceProfiler::stop();
+
+        string trace = readFile(file);
+        Assert::That(occurrences(trace, "\"name\":\"ring\""), Equals(TraceProfiler::EVENTS));
+        remove(file.c_str());
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  QUERY LOG
+// ─────────────────────────────────────────────────────────────
+//
+static QueryRecord sampleQuery(int i) {
+    QueryRecord r;
+    r.timestampUs = 1700000000000000LL + i * 250000LL;
+    r.start = i;
+    r.dest = 1000 - i;
+    r.latencyUs = 40 + i;
+    r.nodesExpanded = 7 * i;
+    r.mode = i % 3;
+    r.flags = i % 2 ? QUERY_FOUND : QUERY_CACHE_HIT | QUERY_MULTI;
+    r.network = i < 250 ? 0xA1 : 0xB2;     // a reload part way
+    return r;
+}
+
+Describe(query_log) {
+    It(appends_across_recorders_and_reads_back) {
+        string file = "/tmp/query_log_test.bin";
+        remove(file.c_str());
+
+        {
+            QueryRecorder recorder(file);
+            Assert::That(recorder.isOpen(), IsTrue());
+            for (int i = 0; i < 200; i++) recorder.record(sampleQuery(i));
+            Assert::That(recorder.recorded(), Equals(201L));    // and a marker
+        }
+        {
+            QueryRecorder recorder(file);
+            for (int i = 200; i < 300; i++) recorder.record(sampleQuery(i));
+        }
+
+        ArrayList<QueryRecord> log;
+        Assert::That(readQueryLog(file, log), IsTrue());
+        Assert::That(log.size(), Equals(300));
+        for (int i = 0; i < 300; i++) {
+            QueryRecord expected = sampleQuery(i);
+            Assert::That(log[i].timestampUs, Equals(expected.timestampUs));
+            Assert::That(log[i].start, Equals(expected.start));
+            Assert::That(log[i].dest, Equals(expected.dest));
+            Assert::That(log[i].latencyUs, Equals(expected.latencyUs));
+            Assert::That(log[i].nodesExpanded, Equals(expected.nodesExpanded));
+            Assert::That(log[i].mode, Equals(expected.mode));
+            Assert::That(log[i].flags, Equals(expected.flags));
+            Assert::That(log[i].network, Equals(expected.network));
+        }
+        remove(file.c_str());
+    }
+
+    It(leaves_other_files_alone) {
+        string file = "/tmp/query_log_test.txt";
+        {
+            ofstream out(file);
+            out << "not a query log\n";
+        }
+
+        QueryRecorder recorder(file);
+        Assert::That(recorder.isOpen(), IsFalse());
+        recorder.record(sampleQuery(1));
+
+        ArrayList<QueryRecord> log;
+        Assert::That(readQueryLog(file, log), IsFalse());
+        Assert::That(readFile(file), Equals(string("not a query log\n")));
+        remove(file.c_str());
+    }
+
+    It(fingerprints_the_airports) {
+        Graph a, b, renamed;
+        generateGraph(a, 30, 3);
+        generateGraph(b, 30, 5, 9);     // other flights, same airports
+        generateGraph(renamed, 30, 3);
+        renamed.vertices[7]->data = "Elsewhere";
+
+        Assert::That(networkFingerprint(b), Equals(networkFingerprint(a)));
+        Assert::That(networkFingerprint(renamed) != networkFingerprint(a), IsTrue());
+
+        Graph fewer;
+        generateGraph(fewer, 29, 3);
+        Assert::That(networkFingerprint(fewer) != networkFingerprint(a), IsTrue());
+    }
+
+    It(drops_a_torn_record_before_appending) {
+        string file = "/tmp/query_log_torn.bin";
+        remove(file.c_str());
+        {
+            QueryRecorder recorder(file);
+            for (int i = 0; i < 3; i++) recorder.record(sampleQuery(i));
+        }
+        {
+            // Half a record, as if the app died mid-write
+            char packed[QUERY_RECORD_BYTES];
+            packQueryRecord(sampleQuery(99), packed);
+            ofstream out(file, ios::binary | ios::app);
+            out.write(packed, 11);
+        }
+        {
+            QueryRecorder recorder(file);
+            Assert::That(recorder.isOpen(), IsTrue());
+            for (int i = 3; i < 5; i++) recorder.record(sampleQuery(i));
+        }
+
+        ArrayList<QueryRecord> log;
+        Assert::That(readQueryLog(file, log), IsTrue());
+        Assert::That(log.size(), Equals(5));
+        for (int i = 0; i < 5; i++) {
+            Assert::That(log[i].timestampUs, Equals(sampleQuery(i).timestampUs));
+            Assert::That(log[i].start, Equals(i));
+            Assert::That(log[i].flags, Equals(sampleQuery(i).flags));
+        }
+        // Five queries and each recorder's network marker
+        Assert::That((long)readFile(file).size(), Equals(8L + 7 * QUERY_RECORD_BYTES));
+        remove(file.c_str());
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  GRAPH SNAPSHOTS AND HOT RELOAD
+// ─────────────────────────────────────────────────────────────
+//
+// A published value whose every slot holds its version, so a reader can
+// tell a whole version from a torn or freed one.
+struct Versioned {
+    static atomic<int> freed;
+    long slots[64];
+
+    explicit Versioned(long version) {
+        for (int i = 0; i < 64; i++) slots[i] = version;
+    }
+
+    ~Versioned() {
+        for (int i = 0; i < 64; i++) slots[i] = -1;
+        freed++;
+    }
+};
+
+atomic<int> Versioned::freed(0);
+
+static void writeNetwork(const string& vertices, const string& edges, const string& lines) {
+    ofstream v(vertices);
+    v << "A\nB\nC\n";
+    v.close();
+    ofstream e(edges);
+    e << lines;
+    e.close();
+}
+
+static bool waitFor(const DataWatcher& watcher, long reloads, long failures) {
+    for (int i = 0; i < 300; i++) {
+        if (watcher.reloadCount() >= reloads && watcher.failureCount() >= failures)
+            return true;
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    return false;
+}
+
+static void countReload(void* context) {
+    (*static_cast<atomic<int>*>(context))++;
+}
+
+Describe(graph_snapshots) {
+    It(keeps_old_versions_until_released) {
+        Versioned::freed = 0;
+        {
+            SnapshotStore<Versioned> store;
+            Assert::That(store.acquire().empty(), IsTrue());
+
+            Assert::That(store.publish(new Versioned(1)), Equals(1L));
+            SnapshotRef<Versioned> held = store.acquire();
+            Assert::That(store.publish(new Versioned(2)), Equals(2L));
+
+            Assert::That(held.version(), Equals(1L));
+            Assert::That(held->slots[63], Equals(1L));
+            Assert::That(store.acquire()->slots[0], Equals(2L));
+            Assert::That(store.collect(), Equals(1));
+            Assert::That(Versioned::freed.load(), Equals(0));
+
+            SnapshotRef<Versioned> copy = held;
+            held = store.acquire();
+            Assert::That(store.collect(), Equals(1));
+            copy = SnapshotRef<Versioned>();
+            Assert::That(store.collect(), Equals(0));
+            Assert::That(Versioned::freed.load(), Equals(1));
+        }
+        Assert::That(Versioned::freed.load(), Equals(2));
+    }
+
+    It(readers_see_whole_versions_while_a_writer_publishes) {
+        Versioned::freed = 0;
+        const int VERSIONS = 300;
+        SnapshotStore<Versioned> store;
+        store.publish(new Versioned(1));
+
+        atomic<bool> done(false);
+        atomic<int> bad(0);
+        thread readers[4];
+        for (int t = 0; t < 4; t++) {
+            readers[t] = thread([&] {
+                long last = 0;
+                while (!done) {
+                    SnapshotRef<Versioned> ref = store.acquire();
+                    long version = ref.version();
+                    for (int i = 0; i < 64; i++)
+                        if (ref->slots[i] != version) bad++;
+                    if (version < last) bad++;
+                    last = version;
+                }
+            });
+        }
+
+        for (long v = 2; v <= VERSIONS; v++) {
+            store.publish(new Versioned(v));
+            if (v % 50 == 0) this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        done = true;
+        for (int t = 0; t < 4; t++) readers[t].join();
+
+        Assert::That(bad.load(), Equals(0));
+        Assert::That(store.collect(), Equals(0));
+        Assert::That(Versioned::freed.load(), Equals(VERSIONS - 1));
+    }
+
+    It(reloads_changed_files_and_keeps_the_last_good_version) {
+        string vertices = "/tmp/snapshot_vertices.csv";
+        string edges = "/tmp/snapshot_edges.csv";
+        writeNetwork(vertices, edges, "0,1,100,60\n1,2,100,60\n0,2,500,90\n");
+
+        ThreadPool pool(2);
+        SnapshotStore<FlightData> store;
+        store.publish(loadFlightData(vertices, edges, pool));
+        SnapshotRef<FlightData> before = store.acquire();
+        Assert::That(before->complete, IsTrue());
+
+        atomic<int> notified(0);
+        DataWatcher watcher(store, vertices, edges, pool, countReload, &notified, 10);
+
+        // A cheaper direct flight
+        writeNetwork(vertices, edges, "0,1,100,60\n1,2,100,60\n0,2,50,90\n");
+        Assert::That(waitFor(watcher, 1, 0), IsTrue());
+        Assert::That(store.version(), Equals(2L));
+        Assert::That(notified.load(), Equals(1));
+
+        SnapshotRef<FlightData> after = store.acquire();
+        Assert::That(after->cheapest->route(0, 2, USE_PRICE).totalPrice, Equals(50));
+        Assert::That(before->cheapest->route(0, 2, USE_PRICE).totalPrice, Equals(200));
+
+        // A broken file is not published
+        writeNetwork(vertices, edges, "0,1,100,60\n1,x,100,60\n");
+        Assert::That(waitFor(watcher, 1, 1), IsTrue());
+        Assert::That(store.version(), Equals(2L));
+        Assert::That(store.acquire()->cheapest->route(0, 2, USE_PRICE).totalPrice, Equals(50));
+
+        remove(vertices.c_str());
+        remove(edges.c_str());
+    }
+
+    It(search_worker_frees_outstanding_jobs_when_destroyed) {
+        static atomic<int> handed(0);
+        handed = 0;
+
+        ThreadPool pool(1);
+        SnapshotStore<FlightData> store;
+        FlightData* data = new FlightData();
+        generateGraph(data->g, 20000, 8);
+        data->flat = new FlatGraph(data->g);
+        data->fewestStops = new DirectionOptimizingBFS(*data->flat, pool);
+        data->cheapest = new SearchTreeCache(*data->flat);
+        data->within = new BudgetSearch(*data->flat);
+        data->anyToAny = new Dijkstra(*data->flat);
+        store.publish(data);
+
+        {
+            SearchWorker worker([](SearchJob* job) { handed++; delete job; });
+            SnapshotRef<FlightData> on = store.acquire();
+            for (int i = 0; i < 2; i++) {
+                SearchJob* job = new SearchJob(i, on, on->g.vertices[0], nullptr, 0, nullptr);
+                job->budget = 1000000;
+                worker.submit(job);
+            }
+        }
+
+        // The first job at most was retired normally; the rest were
+        // deleted, so nothing holds the old version.
+        Assert::That(handed.load(), IsLessThanOrEqualTo(1));
+        store.publish(new FlightData());
+        Assert::That(store.collect(), Equals(0));
+    }
+};
+
+//
+// ─────────────────────────────────────────────────────────────
+//  TIMING BASELINE
+// ─────────────────────────────────────────────────────────────
+//
+// test/perf_baseline.txt holds one "name milliseconds" line per timed
+// hot path, recorded on the reference machine with this build's flags.
+// A hot path fails when its median time exceeds the baseline by more
+// than PERF_MARGIN percent (default 50), plus half a millisecond of
+// scheduler jitter. PERF_UPDATE=1 records the current timings instead
+// of checking them; paths with no baseline yet only report theirs.
+//
+//   PERF_MARGIN=20 make test
+//   PERF_UPDATE=1 make test
+//
+struct PerfBaseline {
+    string file;
+    double margin;
+    bool update;
+    ArrayList<string> names;
+    ArrayList<double> millis;
+
+    PerfBaseline() {
+        const char* path = getenv("PERF_BASELINE");
+        const char* percent = getenv("PERF_MARGIN");
+        const char* record = getenv("PERF_UPDATE");
+        file = path ? path : "test/perf_baseline.txt";
+        margin = percent ? atof(percent) : 50;
+        update = record && string(record) != "0";
+
+        ifstream in(file);
+        string name;
+        double ms;
+        while (in >> name >> ms) {
+            names.append(name);
+            millis.append(ms);
+        }
+    }
+
+    int find(const string& name) const {
+        for (int i = 0; i < names.size(); i++)
+            if (names[i] == name) return i;
+        return -1;
+    }
+
+    // Limit for `name`, or a negative number when there is no baseline.
+    double limit(const string& name) const {
+        int i = find(name);
+        return i < 0 ? -1 : millis[i] * (1 + margin / 100) + 0.5;
+    }
+
+    void record(const string& name, double ms) {
+        int i = find(name);
+        if (i < 0) {
+            names.append(name);
+            millis.append(ms);
+        } else {
+            millis[i] = ms;
+        }
+    }
+
+    bool save() const {
+        ofstream out(file);
+        if (!out.is_open()) return false;
+
+        for (int i = 0; i < names.size(); i++)
+            out << names[i] << " " << millis[i] << "\n";
+        return true;
+    }
+};
+
+static PerfBaseline& baseline() {
+    static PerfBaseline perf;
+    return perf;
+}
+
+// Median of `runs` timings of body(), in milliseconds.
+template <typename Body>
+static double medianMillis(int runs, Body body) {
+    double* times = new double[runs];
+    for (int r = 0; r < runs; r++) {
+        auto started = chrono::steady_clock::now();
+        body();
+        times[r] = millisSince(started);
+    }
+
+    mergeSort(times, runs);
+    double median = times[runs / 2];
+    delete[] times;
+    return median;
+}
+
+static void checkTiming(const string& name, double ms) {
+    PerfBaseline& perf = baseline();
+    double limit = perf.limit(name);
+
+    if (perf.update) {
+        perf.record(name, ms);
+        cout << "  recorded " << name << ": " << ms << " ms" << endl;
+    } else if (limit < 0) {
+        cout << "  no baseline for " << name << ": " << ms << " ms" << endl;
+    } else {
+        Assert::That(ms, IsLessThanOrEqualTo(limit));
+    }
+}
+
+//
+// ─────────────────────────────────────────────────────────────
+//  TIMING TESTS
+// ─────────────────────────────────────────────────────────────
+//
+Describe(hot_paths_stay_within_baseline) {
+    It(array_list_append_and_index) {
+        double ms = medianMillis(7, [] {
+            ArrayList<int> list;
+            for (int i = 0; i < 200000; i++) list.append(i);
+
+            long sum = 0;
+            for (int i = 0; i < list.size(); i++) sum += list[i];
+            Assert::That(sum, Equals(199999L * 200000 / 2));
+        });
+        checkTiming("array_list_append_and_index", ms);
+    }
+
+    It(hash_table_insert_and_search) {
+        double ms = medianMillis(7, [] {
+            HashTable<string> table;
+            for (int i = 0; i < 5000; i++) table.insert("V" + to_string(i));
+
+            int hits = 0;
+            for (int i = 0; i < 10000; i++)
+                if (table.search("V" + to_string(i))) hits++;
+            Assert::That(hits, Equals(5000));
+        });
+        checkTiming("hash_table_insert_and_search", ms);
+    }
+
+    It(queue_enqueue_dequeue) {
+        double ms = medianMillis(7, [] {
+            Queue<int> queue;
+            long sum = 0;
+            for (int round = 0; round < 200; round++) {
+                for (int i = 0; i < 100; i++) queue.enqueue(i);
+                while (!queue.isEmpty()) sum += queue.dequeue();
+            }
+            Assert::That(sum, Equals(200L * 4950));
+        });
+        checkTiming("queue_enqueue_dequeue", ms);
+    }
+
+    It(graph_ucs) {
+        Graph g;
+        generateGraph(g, 400, 6, 5);
+        double ms = medianMillis(5, [&] {
+            for (int i = 0; i < 10; i++)
+                g.ucs(g.vertices[i], g.vertices[399 - i], i % 2 ? USE_TIME : USE_PRICE);
+        });
+        checkTiming("graph_ucs", ms);
+    }
+
+    It(graph_bfs) {
+        Graph g;
+        generateGraph(g, 400, 6, 5);
+        double ms = medianMillis(5, [&] {
+            for (int i = 0; i < 10; i++)
+                g.bfs(g.vertices[i], g.vertices[399 - i]);
+        });
+        checkTiming("graph_bfs", ms);
+    }
+
+    It(flat_dijkstra) {
+        Graph g;
+        generateGraph(g, 5000, 8, 5);
+        FlatGraph flat(g);
+        Dijkstra dijkstra(flat);
+        double ms = medianMillis(5, [&] {
+            for (int i = 0; i < 50; i++)
+                dijkstra.query(i, 4999 - i, i % 2 ? USE_TIME : USE_PRICE);
+        });
+        checkTiming("flat_dijkstra", ms);
+    }
+};
 
 int main(int argc, const char* argv[]){
-    TestRunner::RunAllTests(argc, argv);
-}
\ No newline at end of file
+    int failures = TestRunner::RunAllTests(argc, argv);
+
+    PerfBaseline& perf = baseline();
+    if (perf.update && !perf.save()) {
+        cerr << "ERROR: Cannot write timing baseline: " << perf.file << endl;
+        return 1;
+    }
+    return failures;
+}
@@ -0,0 +1,157 @@
+#include <GraphGenerator.h>
+#include <RouteClient.h>
+#include <Sort.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+//
+// ─────────────────────────────────────────────────────────────
+//  ROUTE SERVER LOAD GENERATOR
+// ─────────────────────────────────────────────────────────────
+//
+// Opens `clients` connections and sends `queries` random requests on
+// each, keeping up to `depth` in flight, then reports throughput and the
+// latency distribution.
+//
+//   loadgen [--socket PATH] [--clients C] [--queries Q] [--depth D]
+//           [--mode price|time|stops|mixed] [--seed S]
+//
+struct Worker {
+    int queries;
+    int depth;
+    int mode;           // RouteMode, or -1 for mixed
+    uint64_t seed;
+    int vertices;
+    string socketPath;
+
+    double* latency;    // microseconds, one per completed query
+    int completed;
+    int failures;       // lost or rejected queries
+};
+
+static void runWorker(Worker* w) {
+    RouteClient client;
+    w->completed = 0;
+    w->failures = 0;
+    if (!client.connect(w->socketPath)) {
+        w->failures = w->queries;
+        return;
+    }
+
+    Random rng(w->seed);
+    auto* sentAt = new chrono::steady_clock::time_point[w->queries];
+    int sent = 0, received = 0;
+
+    auto sendOne = [&]() {
+        RouteMode mode = (RouteMode)(w->mode >= 0 ? w->mode : rng.between(0, 2));
+        sentAt[sent] = chrono::steady_clock::now();
+        client.send(rng.between(0, w->vertices - 1),
+                    rng.between(0, w->vertices - 1), mode);
+        sent++;
+    };
+
+    while (sent < w->queries && sent < w->depth)
+        sendOne();
+
+    while (received < sent) {
+        RouteReply reply;
+        if (!client.receive(reply)) {
+            w->failures += sent - received;
+            break;
+        }
+
+        int index = reply.header.tag - 1;
+        w->latency[received++] = chrono::duration<double, micro>(
+            chrono::steady_clock::now() - sentAt[index]).count();
+        if (reply.header.status == ROUTE_BAD_QUERY)
+            w->failures++;
+
+        if (sent < w->queries)
+            sendOne();
+    }
+    w->completed = received;
+
+    delete[] sentAt;
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath = "/tmp/flight-planner.sock";
+    int clients = 8;
+    int queries = 1000;
+    int depth = 1;
+    int mode = -1;
+    uint64_t seed = 1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        string value = argv[i + 1];
+
+        if (flag == "--socket") socketPath = value;
+        else if (flag == "--clients") clients = atoi(value.c_str());
+        else if (flag == "--queries") queries = atoi(value.c_str());
+        else if (flag == "--depth") depth = atoi(value.c_str());
+        else if (flag == "--seed") seed = atoll(value.c_str());
+        else if (flag == "--mode") {
+            mode = value == "price" ? MODE_PRICE
+                 : value == "time"  ? MODE_TIME
+                 : value == "stops" ? MODE_STOPS : -1;
+        } else {
+            cerr << "Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    RouteClient probe;
+    int vertices = probe.connect(socketPath) ? probe.vertexCount() : -1;
+    probe.disconnect();
+    if (vertices <= 0) {
+        cerr << "ERROR: No route server on " << socketPath << endl;
+        return 1;
+    }
+
+    Worker* workers = new Worker[clients];
+    thread* threads = new thread[clients];
+
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < clients; i++) {
+        workers[i] = { queries, depth, mode, seed + i, vertices, socketPath,
+                       new double[queries], 0, 0 };
+        threads[i] = thread(runWorker, &workers[i]);
+    }
+    for (int i = 0; i < clients; i++)
+        threads[i].join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    int total = clients * queries;
+    int failures = 0;
+    double* all = new double[total];
+    int count = 0;
+    for (int i = 0; i < clients; i++) {
+        failures += workers[i].failures;
+        for (int j = 0; j < workers[i].completed; j++)
+            all[count++] = workers[i].latency[j];
+        delete[] workers[i].latency;
+    }
+    mergeSort(all, count);
+
+    cout << clients << " clients x " << queries << " queries, depth " << depth
+         << " against " << vertices << " airports" << endl;
+    cout << "  throughput: " << (int)(count / seconds) << " queries/s" << endl;
+    if (count > 0) {
+        cout << "  latency p50: " << all[count / 2] << " us" << endl;
+        cout << "  latency p90: " << all[count * 9 / 10] << " us" << endl;
+        cout << "  latency p99: " << all[count * 99 / 100] << " us" << endl;
+        cout << "  latency max: " << all[count - 1] << " us" << endl;
+    }
+    cout << "  failures: " << failures << endl;
+
+    delete[] all;
+    delete[] workers;
+    delete[] threads;
+    return failures > 0;
+}
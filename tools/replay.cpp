@@ -0,0 +1,231 @@
+#include <CustomizableOverlay.h>
+#include <Dijkstra.h>
+#include <GraphGenerator.h>
+#include <GraphLoader.h>
+#include <HubLabels.h>
+#include <Landmarks.h>
+#include <ParallelBFS.h>
+#include <QueryLog.h>
+#include <SearchTreeCache.h>
+#include <Sort.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+//
+// ─────────────────────────────────────────────────────────────
+//  QUERY LOG REPLAY
+// ─────────────────────────────────────────────────────────────
+//
+// Reruns a query log (FLIGHT_QUERY_LOG) against one or all engines over
+// the same network, one query at a time as the app asks them. At
+// --speed max queries go back to back; at "original" (or a factor such
+// as 10 for ten times faster) each is issued when the log says it was
+// asked, and response time counts any wait behind a slower query.
+// Engines with no fewest-stops search answer those with the app's BFS.
+// Only queries recorded on this same network (same airports in the same
+// order) are replayed; a log with none is refused.
+//
+//   replay LOG [--vertices CSV] [--edges CSV] [--synthetic N]
+//              [--engine app|dijkstra|alt|hubs|overlay|all]
+//              [--speed max|original|FACTOR]
+//
+struct Replayed {
+    double* service;    // search time, microseconds
+    double* response;   // from the query's scheduled time
+    long expanded;
+    int count;
+    int differ;         // found / not found disagrees with the log
+};
+
+static void percentiles(const string& label, double* us, int count) {
+    if (count == 0) return;
+    mergeSort(us, count);
+    cout << "  " << label << " p50 " << us[count / 2] << " us, p90 "
+         << us[count * 9 / 10] << " us, p99 " << us[count * 99 / 100]
+         << " us, max " << us[count - 1] << " us" << endl;
+}
+
+// answer(start, dest, mode) returns the engine's Route.
+template <class Answer>
+static void replay(const string& name, const ArrayList<QueryRecord>& log,
+                   double speed, Answer answer) {
+    int n = log.size();
+    Replayed r = { new double[n], new double[n], 0, 0, 0 };
+
+    auto began = chrono::steady_clock::now();
+    long long first = n > 0 ? log[0].timestampUs : 0;
+    for (int i = 0; i < n; i++) {
+        const QueryRecord& q = log[i];
+        auto due = chrono::steady_clock::now();
+        if (speed > 0) {
+            long long offset = (long long)((q.timestampUs - first) / speed);
+            due = began + chrono::microseconds(offset);
+            this_thread::sleep_until(due);
+        }
+
+        auto asked = chrono::steady_clock::now();
+        Route route = answer(q.start, q.dest, q.mode);
+        auto answered = chrono::steady_clock::now();
+
+        r.service[r.count] = chrono::duration<double, micro>(answered - asked).count();
+        r.response[r.count] = chrono::duration<double, micro>(answered - due).count();
+        r.expanded += route.stats.nodesExpanded;
+        if (!(q.flags & QUERY_MULTI) && route.found() != q.found()) r.differ++;
+        r.count++;
+    }
+    double ms = millisSince(began);
+
+    cout << name << ": " << r.count << " queries in " << ms << " ms, "
+         << (r.count > 0 ? r.expanded / r.count : 0) << " nodes expanded per query, "
+         << r.differ << " answers differ from the log" << endl;
+    percentiles("search  ", r.service, r.count);
+    if (speed > 0) percentiles("response", r.response, r.count);
+
+    delete[] r.service;
+    delete[] r.response;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: replay LOG [--engine NAME] [--speed max|original|FACTOR]" << endl;
+        return 1;
+    }
+
+    string logFile = argv[1];
+    string vertices = "assets/vertices.csv";
+    string edges = "assets/edges.csv";
+    string engine = "all";
+    int synthetic = 0;
+    double speed = 0;   // 0: as fast as possible
+
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        string value = argv[i + 1];
+
+        if (flag == "--vertices") vertices = value;
+        else if (flag == "--edges") edges = value;
+        else if (flag == "--synthetic") synthetic = atoi(value.c_str());
+        else if (flag == "--engine") engine = value;
+        else if (flag == "--speed") {
+            speed = value == "max" ? 0 : value == "original" ? 1 : atof(value.c_str());
+        } else {
+            cerr << "Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    if (engine != "all" && engine != "app" && engine != "dijkstra" && engine != "alt" &&
+        engine != "hubs" && engine != "overlay") {
+        cerr << "Unknown engine " << engine << endl;
+        return 1;
+    }
+
+    ArrayList<QueryRecord> recorded;
+    if (!readQueryLog(logFile, recorded)) {
+        cerr << "ERROR: " << logFile << " is not a query log" << endl;
+        return 1;
+    }
+
+    ThreadPool pool(0);
+    Graph g;
+    FlatGraph* loaded = nullptr;
+    if (synthetic > 0) {
+        generateGraph(g, synthetic, 8);
+        loaded = new FlatGraph(g);
+    } else if (!loadAirportsCSV(g, vertices) ||
+               !(loaded = loadEdgesCSVParallel(g, edges, pool))) {
+        return 1;
+    }
+    FlatGraph& flat = *loaded;
+
+    // Queries from another network (other data, or before an edit to the
+    // airports) would replay different airport pairs.
+    uint64_t network = networkFingerprint(g);
+    ArrayList<QueryRecord> log;
+    int foreign = 0, skipped = 0;
+    for (int i = 0; i < recorded.size(); i++) {
+        const QueryRecord& q = recorded[i];
+        if (q.network != network)
+            foreign++;
+        else if (q.start < 0 || q.start >= flat.n || q.dest < 0 || q.dest >= flat.n ||
+                 q.mode < 0 || q.mode > 2)
+            skipped++;
+        else
+            log.append(q);
+    }
+    if (foreign > 0 && log.size() == 0) {
+        cerr << "ERROR: " << logFile << " was recorded on a different network" << endl;
+        return 1;
+    }
+
+    int n = log.size();
+    double* latency = new double[n > 0 ? n : 1];
+    long expanded = 0;
+    int hits = 0;
+    for (int i = 0; i < n; i++) {
+        latency[i] = log[i].latencyUs;
+        expanded += log[i].nodesExpanded;
+        if (log[i].flags & QUERY_CACHE_HIT) hits++;
+    }
+    double span = n > 1 ? (log[n - 1].timestampUs - log[0].timestampUs) / 1e6 : 0;
+    cout << logFile << ": " << n << " queries over " << span << " s ("
+         << foreign << " from another network, " << skipped << " skipped, "
+         << hits << " cache hits), "
+         << (n > 0 ? expanded / n : 0) << " nodes expanded per query" << endl;
+    percentiles("recorded", latency, n);
+    delete[] latency;
+
+    ThreadPool inlinePool(1);
+    DirectionOptimizingBFS bfs(flat, inlinePool);
+    auto stops = [&](int s, int t) { return bfs.route(s, t); };
+    auto weight = [](int mode) { return mode == 0 ? USE_PRICE : USE_TIME; };
+    bool all = engine == "all";
+
+    if (all || engine == "app") {
+        SearchTreeCache trees(flat);
+        replay("app (search trees + BFS)", log, speed, [&](int s, int t, int mode) {
+            return mode == 2 ? stops(s, t) : trees.route(s, t, weight(mode));
+        });
+    }
+
+    if (all || engine == "dijkstra") {
+        Dijkstra dijkstra(flat);
+        replay("dijkstra", log, speed, [&](int s, int t, int mode) {
+            ArrayList<int> from, to;
+            from.append(s);
+            to.append(t);
+            return mode == 2 ? dijkstra.fewestStops(from, to)
+                             : dijkstra.route(from, to, weight(mode));
+        });
+    }
+
+    if (all || engine == "alt") {
+        Landmarks landmarks(flat, pool, 16);
+        AltSearch alt(flat, landmarks);
+        replay("alt (16 landmarks)", log, speed, [&](int s, int t, int mode) {
+            return mode == 2 ? stops(s, t) : alt.route(s, t, weight(mode));
+        });
+    }
+
+    if (all || engine == "hubs") {
+        HubLabels labels(flat);
+        replay("hub labels", log, speed, [&](int s, int t, int mode) {
+            return mode == 2 ? stops(s, t) : labels.route(flat, s, t, weight(mode));
+        });
+    }
+
+    if (all || engine == "overlay") {
+        CustomizableOverlay overlay(flat);
+        overlay.customize(pool);
+        OverlayQuery query(overlay);
+        replay("customizable overlay", log, speed, [&](int s, int t, int mode) {
+            return mode == 2 ? stops(s, t) : query.route(s, t, weight(mode));
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <GraphGenerator.h>
+#include <GraphLoader.h>
+#include <RouteServer.h>
+#include <TraceProfiler.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+//
+// ─────────────────────────────────────────────────────────────
+//  ROUTE SERVER DAEMON
+// ─────────────────────────────────────────────────────────────
+//
+// Loads the graph once and answers RouteRequests on a Unix socket until
+// SIGINT/SIGTERM.
+//
+//   route_server [--socket PATH] [--vertices CSV] [--edges CSV]
+//                [--synthetic N] [--threads T] [--batch N] [--window US]
+//
+static RouteServer* running = nullptr;
+
+static void onSignal(int) {
+    if (running) running->stop();
+}
+
+int main(int argc, char* argv[]) {
+    string socketPath = "/tmp/flight-planner.sock";
+    string vertices = "assets/vertices.csv";
+    string edges = "assets/edges.csv";
+    int synthetic = 0;
+    int threads = 0;
+    int batch = 256;
+    int window = 200;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        string value = argv[i + 1];
+
+        if (flag == "--socket") socketPath = value;
+        else if (flag == "--vertices") vertices = value;
+        else if (flag == "--edges") edges = value;
+        else if (flag == "--synthetic") synthetic = atoi(value.c_str());
+        else if (flag == "--threads") threads = atoi(value.c_str());
+        else if (flag == "--batch") batch = atoi(value.c_str());
+        else if (flag == "--window") window = atoi(value.c_str());
+        else {
+            cerr << "Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    // FLIGHT_TRACE=<file>: Chrome trace of loading and every batch.
+    TraceProfiler::nameThread("main");
+    TraceProfiler::startFromEnvironment();
+
+    ThreadPool pool(threads);
+    Graph g;
+    FlatGraph* loaded = nullptr;
+    if (synthetic > 0) {
+        generateGraph(g, synthetic, 8);
+        loaded = new FlatGraph(g);
+    } else if (!loadAirportsCSV(g, vertices) ||
+               !(loaded = loadEdgesCSVParallel(g, edges, pool))) {
+        return 1;
+    }
+
+    FlatGraph& flat = *loaded;
+    RouteEngine engine(flat, pool.size());
+    RouteServer server(engine, pool, batch, window);
+
+    if (!server.listen(socketPath)) {
+        cerr << "ERROR: Cannot listen on " << socketPath << endl;
+        return 1;
+    }
+
+    running = &server;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    cout << "Serving " << flat.n << " airports on " << socketPath << " with "
+         << pool.size() << " workers" << endl;
+
+    server.serve();
+
+    cout << server.requestCount() << " requests in " << server.batchCount()
+         << " batches, " << server.computedCount() << " searches" << endl;
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <GraphGenerator.h>
+#include <GraphLoader.h>
+#include <ShardedRouting.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+//
+// ─────────────────────────────────────────────────────────────
+//  SHARDED ROUTER
+// ─────────────────────────────────────────────────────────────
+//
+// `split` partitions a network by recursive bisection and writes one
+// file per shard plus the overlay file. `query` starts one worker
+// process per shard (each loads only its own file), builds the overlay
+// from their boundary distances and times random route queries; it
+// never loads the whole network.
+//
+//   shard_router split [--prefix P] [--parts K] [--vertices CSV]
+//                      [--edges CSV] [--synthetic N] [--regions R]
+//   shard_router query [--prefix P] [--queries Q] [--seed S]
+//
+static int split(const string& prefix, int parts, const string& vertices,
+                 const string& edges, int synthetic, int regions) {
+    Graph g;
+    if (synthetic > 0 && regions > 0)
+        generateRegionalGraph(g, synthetic, 8, regions);
+    else if (synthetic > 0)
+        generateGraph(g, synthetic, 8);
+    else if (!loadAirportsCSV(g, vertices) || !loadEdgesCSV(g, edges))
+        return 1;
+
+    FlatGraph flat(g);
+    auto started = chrono::steady_clock::now();
+    RecursiveBisection bisection(flat);
+    Partition* partition = bisection.run(parts);
+    double ms = millisSince(started);
+
+    if (!writeShards(flat, *partition, prefix)) {
+        cerr << "ERROR: Cannot write shards to " << prefix << endl;
+        delete partition;
+        return 1;
+    }
+
+    cout << flat.n << " airports, " << flat.m / 2 << " routes in "
+         << partition->parts << " shards (" << ms << " ms)" << endl;
+    for (int p = 0; p < partition->parts; p++)
+        cout << "  " << shardFile(prefix, p) << ": " << partition->size(p)
+             << " airports" << endl;
+    cout << "  " << partition->cutEdges << " routes between shards" << endl;
+
+    delete partition;
+    return 0;
+}
+
+static int query(const string& prefix, int queries, uint64_t seed) {
+    ShardCoordinator coordinator;
+    auto started = chrono::steady_clock::now();
+    if (!coordinator.launch(prefix)) {
+        cerr << "ERROR: Cannot start shards from " << prefix << endl;
+        return 1;
+    }
+
+    cout << coordinator.partCount() << " shard workers up in "
+         << millisSince(started) << " ms; overlay " << coordinator.overlayVertices()
+         << " vertices, " << coordinator.overlayArcs() << " arcs" << endl;
+
+    Random rng(seed);
+    int found = 0, failed = 0;
+    auto timing = chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        int start = rng.between(0, coordinator.vertexCount() - 1);
+        int dest = rng.between(0, coordinator.vertexCount() - 1);
+        RouteReply reply = coordinator.route(start, dest, q % 3);
+
+        if (reply.header.status == ROUTE_OK) found++;
+        else if (reply.header.status == ROUTE_BAD_QUERY) failed++;
+    }
+    double ms = millisSince(timing);
+
+    cout << queries << " queries in " << ms << " ms ("
+         << (queries > 0 ? ms * 1000 / queries : 0) << " us each), "
+         << found << " routes found, " << failed << " failed" << endl;
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: shard_router split|query [options]" << endl;
+        return 1;
+    }
+
+    string command = argv[1];
+    string prefix = "/tmp/flight-shards";
+    string vertices = "assets/vertices.csv";
+    string edges = "assets/edges.csv";
+    int parts = 4;
+    int synthetic = 0;
+    int regions = 0;
+    int queries = 1000;
+    uint64_t seed = 1;
+
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        string value = argv[i + 1];
+
+        if (flag == "--prefix") prefix = value;
+        else if (flag == "--parts") parts = atoi(value.c_str());
+        else if (flag == "--vertices") vertices = value;
+        else if (flag == "--edges") edges = value;
+        else if (flag == "--synthetic") synthetic = atoi(value.c_str());
+        else if (flag == "--regions") regions = atoi(value.c_str());
+        else if (flag == "--queries") queries = atoi(value.c_str());
+        else if (flag == "--seed") seed = strtoull(value.c_str(), nullptr, 10);
+        else {
+            cerr << "Unknown option " << flag << endl;
+            return 1;
+        }
+    }
+
+    if (command == "split") return split(prefix, parts, vertices, edges, synthetic, regions);
+    if (command == "query") return query(prefix, queries, seed);
+
+    cerr << "Unknown command " << command << endl;
+    return 1;
+}